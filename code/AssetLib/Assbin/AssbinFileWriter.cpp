@@ -448,6 +448,9 @@ protected:
         if (mesh->mTangents && mesh->mBitangents) {
             c |= ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS;
         }
+        if (mesh->mBVH) {
+            c |= ASSBIN_MESH_HAS_BVH;
+        }
         for (unsigned int n = 0; n < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++n) {
             if (!mesh->mTextureCoords[n]) {
                 break;
@@ -558,6 +561,26 @@ protected:
                 WriteBinaryBone(&chunk, b);
             }
         }
+
+        if (mesh->mBVH) {
+            WriteBinaryBVH(&chunk, mesh->mBVH);
+        }
+    }
+
+    // -----------------------------------------------------------------------------------
+    void WriteBinaryBVH(IOStream *container, const aiBVH *bvh) {
+        AssbinChunkWriter chunk(container, ASSBIN_CHUNK_AIBVH);
+
+        Write<unsigned int>(&chunk, bvh->mNumNodes);
+        Write<unsigned int>(&chunk, bvh->mNumPrimitives);
+        for (unsigned int i = 0; i < bvh->mNumNodes; ++i) {
+            const aiBVHNode &node = bvh->mNodes[i];
+            Write<aiVector3D>(&chunk, node.mAABB.mMin);
+            Write<aiVector3D>(&chunk, node.mAABB.mMax);
+            Write<unsigned int>(&chunk, node.mOffset);
+            Write<unsigned int>(&chunk, node.mNumPrimitives);
+        }
+        WriteArray<unsigned int>(&chunk, bvh->mPrimitives, bvh->mNumPrimitives);
     }
 
     // -----------------------------------------------------------------------------------
@@ -727,6 +750,11 @@ protected:
             const aiCamera *cam = scene->mCameras[i];
             WriteBinaryCamera(&chunk, cam);
         }
+
+        // the BVH comes last, so readers which don't know it can ignore it
+        if (scene->mBVH) {
+            WriteBinaryBVH(&chunk, scene->mBVH);
+        }
     }
 
 public:
@@ -424,6 +424,35 @@ void AssbinImporter::ReadBinaryMesh(IOStream *stream, aiMesh *mesh) {
             ReadBinaryBone(stream, mesh->mBones[a]);
         }
     }
+
+    if (c & ASSBIN_MESH_HAS_BVH) {
+        mesh->mBVH = new aiBVH();
+        ReadBinaryBVH(stream, mesh->mBVH);
+    }
+}
+
+// -----------------------------------------------------------------------------------
+void AssbinImporter::ReadBinaryBVH(IOStream *stream, aiBVH *bvh) {
+    if (Read<uint32_t>(stream) != ASSBIN_CHUNK_AIBVH)
+        throw DeadlyImportError("Magic chunk identifiers are wrong!");
+    /*uint32_t size =*/Read<uint32_t>(stream);
+
+    bvh->mNumNodes = Read<unsigned int>(stream);
+    bvh->mNumPrimitives = Read<unsigned int>(stream);
+    if (bvh->mNumNodes) {
+        bvh->mNodes = new aiBVHNode[bvh->mNumNodes];
+        for (unsigned int i = 0; i < bvh->mNumNodes; ++i) {
+            aiBVHNode &node = bvh->mNodes[i];
+            node.mAABB.mMin = Read<aiVector3D>(stream);
+            node.mAABB.mMax = Read<aiVector3D>(stream);
+            node.mOffset = Read<unsigned int>(stream);
+            node.mNumPrimitives = Read<unsigned int>(stream);
+        }
+    }
+    if (bvh->mNumPrimitives) {
+        bvh->mPrimitives = new unsigned int[bvh->mNumPrimitives];
+        ReadArray<unsigned int>(stream, bvh->mPrimitives, bvh->mNumPrimitives);
+    }
 }
 
 // -----------------------------------------------------------------------------------
@@ -596,7 +625,8 @@ void AssbinImporter::ReadBinaryCamera(IOStream *stream, aiCamera *cam) {
 void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
     if (Read<uint32_t>(stream) != ASSBIN_CHUNK_AISCENE)
         throw DeadlyImportError("Magic chunk identifiers are wrong!");
-    /*uint32_t size =*/Read<uint32_t>(stream);
+    const uint32_t size = Read<uint32_t>(stream);
+    const size_t end = stream->Tell() + size;
 
     scene->mFlags = Read<unsigned int>(stream);
     scene->mNumMeshes = Read<unsigned int>(stream);
@@ -669,6 +699,12 @@ void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
             ReadBinaryCamera(stream, scene->mCameras[i]);
         }
     }
+
+    // Read the optional BVH at the end of the scene chunk
+    if (stream->Tell() + 2 * sizeof(uint32_t) <= end) {
+        scene->mBVH = new aiBVH();
+        ReadBinaryBVH(stream, scene->mBVH);
+    }
 }
 
 // -----------------------------------------------------------------------------------
@@ -683,7 +719,7 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
 
     unsigned int versionMajor = Read<unsigned int>(stream);
     unsigned int versionMinor = Read<unsigned int>(stream);
-    if (versionMinor != ASSBIN_VERSION_MINOR || versionMajor != ASSBIN_VERSION_MAJOR) {
+    if (versionMinor > ASSBIN_VERSION_MINOR || versionMajor != ASSBIN_VERSION_MAJOR) {
         throw DeadlyImportError("Invalid version, data format not compatible!");
     }
 
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 struct aiMesh;
 struct aiNode;
 struct aiBone;
+struct aiBVH;
 struct aiMaterial;
 struct aiMaterialProperty;
 struct aiNodeAnim;
@@ -83,6 +84,7 @@ public:
     void ReadBinaryNode( IOStream * stream, aiNode** mRootNode, aiNode* parent );
     void ReadBinaryMesh( IOStream * stream, aiMesh* mesh );
     void ReadBinaryBone( IOStream * stream, aiBone* bone );
+    void ReadBinaryBVH( IOStream * stream, aiBVH* bvh );
     void ReadBinaryMaterial(IOStream * stream, aiMaterial* mat);
     void ReadBinaryMaterialProperty(IOStream * stream, aiMaterialProperty* prop);
     void ReadBinaryNodeAnim(IOStream * stream, aiNodeAnim* nd);
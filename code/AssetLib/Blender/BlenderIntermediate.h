@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderDNA.h"
 #include "BlenderScene.h"
 #include <deque>
+#include <map>
 #include <assimp/material.h>
 
 struct aiTexture;
@@ -132,6 +133,11 @@ namespace Blender {
     // When keeping objects in sets, sort them by their name.
     typedef std::set<const Object*, ObjectCompare> ObjectSet;
 
+    // Children of each parent object, kept in ObjectSet order. Built once so
+    // that looking up the children of a node does not need a scan over all
+    // objects in the scene.
+    typedef std::map<const Object*, std::deque<const Object*> > ObjectChildrenMap;
+
     // --------------------------------------------------------------------
     /** ConversionData acts as intermediate storage location for
      *  the various ConvertXXX routines in BlenderImporter.*/
@@ -141,6 +147,7 @@ namespace Blender {
         ConversionData(const FileDatabase& db)
             : sentinel_cnt()
             , next_texture()
+            , subdivision_face_budget()
             , db(db)
         {}
 
@@ -153,6 +160,7 @@ namespace Blender {
         };
 
         ObjectSet objects;
+        ObjectChildrenMap children;
 
         TempArray <std::vector, aiMesh> meshes;
         TempArray <std::vector, aiCamera> cameras;
@@ -169,6 +177,9 @@ namespace Blender {
         // next texture ID for each texture type, respectively
         unsigned int next_texture[aiTextureType_UNKNOWN+1];
 
+        // maximum number of faces a subdivision modifier may produce per object, 0 if unlimited
+        unsigned int subdivision_face_budget;
+
         // original file data
         const FileDatabase& db;
     };
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderCustomData.h"
 #include "BlenderIntermediate.h"
 #include "BlenderModifier.h"
+#include <assimp/Importer.hpp>
 #include <assimp/StringUtils.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
@@ -100,7 +101,8 @@ static constexpr aiImporterDesc blenderDesc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter() :
-        modifier_cache(new BlenderModifierShowcase()) {
+        modifier_cache(new BlenderModifierShowcase()),
+        configSubdivisionFaceBudget(0) {
     // empty
 }
 
@@ -126,8 +128,8 @@ const aiImporterDesc *BlenderImporter::GetInfo() const {
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer * /*pImp*/) {
-    // nothing to be done for the moment
+void BlenderImporter::SetupProperties(const Importer *pImp) {
+    configSubdivisionFaceBudget = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_BLEND_SUBDIVISION_FACE_BUDGET, 0);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -271,6 +273,7 @@ void BlenderImporter::ParseSubCollection(const Blender::Scene &in, aiNode *root,
 // ------------------------------------------------------------------------------------------------
 void BlenderImporter::ConvertBlendFile(aiScene *out, const Scene &in, const FileDatabase &file) {
     ConversionData conv(file);
+    conv.subdivision_face_budget = configSubdivisionFaceBudget;
 
     aiNode *root = out->mRootNode = new aiNode("<BlenderRoot>");
     // Iterate over all objects directly under master_collection,
@@ -300,6 +303,10 @@ void BlenderImporter::ConvertBlendFile(aiScene *out, const Scene &in, const File
             ThrowException("Expected at least one object with no parent");
         }
 
+        for (const Object *object : conv.objects) {
+            conv.children[object->parent].push_back(object);
+        }
+
         root->mNumChildren = static_cast<unsigned int>(no_parents.size());
         root->mChildren = new aiNode *[root->mNumChildren]();
         for (unsigned int i = 0; i < root->mNumChildren; ++i) {
@@ -1187,16 +1194,12 @@ aiLight *BlenderImporter::ConvertLight(const Scene & /*in*/, const Object *obj,
 
 // ------------------------------------------------------------------------------------------------
 aiNode *BlenderImporter::ConvertNode(const Scene &in, const Object *obj, ConversionData &conv_data, const aiMatrix4x4 &parentTransform) {
+    // each object is converted only once, so take ownership of the child list
     std::deque<const Object *> children;
-    for (ObjectSet::iterator it = conv_data.objects.begin(); it != conv_data.objects.end();) {
-        const Object *object = *it;
-        if (object->parent == obj) {
-            children.push_back(object);
-
-            conv_data.objects.erase(it++);
-            continue;
-        }
-        ++it;
+    ObjectChildrenMap::iterator it = conv_data.children.find(obj);
+    if (it != conv_data.children.end()) {
+        children.swap(it->second);
+        conv_data.children.erase(it);
     }
 
     std::unique_ptr<aiNode> node(new aiNode(obj->id.name + 2)); // skip over the name prefix 'OB'
@@ -1273,6 +1276,9 @@ aiNode *BlenderImporter::ConvertNode(const Scene &in, const Object *obj, Convers
 
     node->mTransformation = m * node->mTransformation;
 
+    // apply modifiers before descending, so they only ever see the meshes of this node
+    modifier_cache->ApplyModifiers(*node, conv_data, in, *obj);
+
     if (children.size()) {
         node->mNumChildren = static_cast<unsigned int>(children.size());
         aiNode **nd = node->mChildren = new aiNode *[node->mNumChildren]();
@@ -1282,9 +1288,6 @@ aiNode *BlenderImporter::ConvertNode(const Scene &in, const Object *obj, Convers
         }
     }
 
-    // apply modifiers
-    modifier_cache->ApplyModifiers(*node, conv_data, in, *obj);
-
     return node.release();
 }
 
@@ -204,6 +204,7 @@ private: // static stuff, mostly logging and error reporting.
 
 private:
     Blender::BlenderModifierShowcase *modifier_cache;
+    unsigned int configSubdivisionFaceBudget;
 
 }; // !class BlenderImporter
 
@@ -155,7 +155,8 @@ void BlenderModifier_Mirror ::DoIt(aiNode &out, ConversionData &conv_data, const
     ai_assert(mir.modifier.type == ModifierData::eModifierType_Mirror);
     std::shared_ptr<Object> mirror_ob = mir.mirror_ob.lock();
 
-    conv_data.meshes->reserve(conv_data.meshes->size() + out.mNumMeshes);
+    const size_t first_mirrored = conv_data.meshes->size();
+    conv_data.meshes->reserve(first_mirrored + out.mNumMeshes);
 
     // XXX not entirely correct, mirroring on two axes results in 4 distinct objects in blender ...
 
@@ -238,8 +239,9 @@ void BlenderModifier_Mirror ::DoIt(aiNode &out, ConversionData &conv_data, const
     unsigned int *nind = new unsigned int[out.mNumMeshes * 2];
 
     std::copy(out.mMeshes, out.mMeshes + out.mNumMeshes, nind);
-    std::transform(out.mMeshes, out.mMeshes + out.mNumMeshes, nind + out.mNumMeshes,
-            [&out](unsigned int n) { return out.mNumMeshes + n; });
+    for (unsigned int i = 0; i < out.mNumMeshes; ++i) {
+        nind[out.mNumMeshes + i] = static_cast<unsigned int>(first_mirrored + i);
+    }
 
     delete[] out.mMeshes;
     out.mMeshes = nind;
@@ -280,14 +282,22 @@ void BlenderModifier_Subdivision ::DoIt(aiNode &out, ConversionData &conv_data,
 
     std::unique_ptr<Subdivider> subd(Subdivider::Create(algo));
     ai_assert(subd);
-    if (conv_data.meshes->empty()) {
+    subd->SetFaceBudget(conv_data.subdivision_face_budget);
+    if (!out.mNumMeshes) {
         return;
     }
-    aiMesh **const meshes = &conv_data.meshes[conv_data.meshes->size() - out.mNumMeshes];
+
+    // gather the meshes of this node, they need not be stored contiguously
+    std::unique_ptr<aiMesh *[]> meshes(new aiMesh *[out.mNumMeshes]);
+    for (unsigned int i = 0; i < out.mNumMeshes; ++i) {
+        meshes[i] = conv_data.meshes[out.mMeshes[i]];
+    }
     std::unique_ptr<aiMesh *[]> tempmeshes(new aiMesh *[out.mNumMeshes]());
 
-    subd->Subdivide(meshes, out.mNumMeshes, tempmeshes.get(), std::max(mir.renderLevels, mir.levels), true);
-    std::copy(tempmeshes.get(), tempmeshes.get() + out.mNumMeshes, meshes);
+    subd->Subdivide(meshes.get(), out.mNumMeshes, tempmeshes.get(), std::max(mir.renderLevels, mir.levels), true);
+    for (unsigned int i = 0; i < out.mNumMeshes; ++i) {
+        conv_data.meshes[out.mMeshes[i]] = tempmeshes[i];
+    }
 
     ASSIMP_LOG_INFO("BlendModifier: Applied the `Subdivision` modifier to `",
             orig_object.id.name, "`");
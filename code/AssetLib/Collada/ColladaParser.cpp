@@ -755,9 +755,7 @@ void ColladaParser::ReadControllerWeights(XmlNode &node, Collada::Controller &pC
             pController.mWeights.resize(numWeights);
         } else if (currentName == "v" && vertexCount > 0) {
             // read JointIndex - WeightIndex pairs
-            std::string stdText;
-            XmlParser::getValueAsString(currentNode, stdText);
-            const char *text = stdText.c_str();
+            const char *text = currentNode.text().as_string();
             for (std::vector<std::pair<size_t, size_t>>::iterator it = pController.mWeights.begin(); it != pController.mWeights.end(); ++it) {
                 if (text == nullptr) {
                     throw DeadlyImportError("Out of data while reading <vertex_weights>");
@@ -1411,49 +1409,43 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
     XmlParser::getStdStrAttribute(node, "id", id);
     unsigned int count = 0;
     XmlParser::getUIntAttribute(node, "count", count);
-    std::string v;
-    XmlParser::getValueAsString(node, v);
-    v = ai_trim(v);
-    const char *content = v.c_str();
+
+    // parse the values straight from the xml buffer, arrays may be huge
+    const char *content = node.text().as_string();
+    SkipSpacesAndLineEnd(&content);
 
     // read values and store inside an array in the data library
-    mDataLibrary[id] = Data();
     Data &data = mDataLibrary[id];
+    data = Data();
     data.mIsStringArray = isStringArray;
 
     // some exporters write empty data arrays, but we need to conserve them anyways because others might reference them
-    if (content) {
-        if (isStringArray) {
-            data.mStrings.reserve(count);
-            std::string s;
+    if (isStringArray) {
+        data.mStrings.resize(count);
 
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading IDREF_array contents.");
-                }
-
-                s.clear();
-                while (!IsSpaceOrNewLine(*content))
-                    s += *content++;
-                data.mStrings.push_back(s);
-
-                SkipSpacesAndLineEnd(&content);
+        for (std::string &s : data.mStrings) {
+            if (*content == 0) {
+                throw DeadlyImportError("Expected more values while reading IDREF_array contents.");
             }
-        } else {
-            data.mValues.reserve(count);
 
-            for (unsigned int a = 0; a < count; a++) {
-                if (*content == 0) {
-                    throw DeadlyImportError("Expected more values while reading float_array contents.");
-                }
+            const char *start = content;
+            SkipToken(content);
+            s.assign(start, content);
 
-                // read a number
-                ai_real value;
-                content = fast_atoreal_move<ai_real>(content, value);
-                data.mValues.push_back(value);
-                // skip whitespace after it
-                SkipSpacesAndLineEnd(&content);
+            SkipSpacesAndLineEnd(&content);
+        }
+    } else {
+        data.mValues.resize(count);
+
+        for (ai_real &value : data.mValues) {
+            if (*content == 0) {
+                throw DeadlyImportError("Expected more values while reading float_array contents.");
             }
+
+            // read a number
+            content = fast_atoreal_move<ai_real>(content, value);
+            // skip whitespace after it
+            SkipSpacesAndLineEnd(&content);
         }
     }
 }
@@ -1614,17 +1606,15 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
                 if (numPrimitives) // It is possible to define a mesh without any primitives
                 {
                     // case <polylist> - specifies the number of indices for each polygon
-                    std::string v;
-                    XmlParser::getValueAsString(currentNode, v);
-                    const char *content = v.c_str();
-                    vcount.reserve(numPrimitives);
+                    const char *content = currentNode.text().as_string();
+                    vcount.resize(numPrimitives);
                     SkipSpacesAndLineEnd(&content);
-                    for (unsigned int a = 0; a < numPrimitives; a++) {
+                    for (size_t &value : vcount) {
                         if (*content == 0) {
                             throw DeadlyImportError("Expected more values while reading <vcount> contents.");
                         }
                         // read a number
-                        vcount.push_back((size_t)strtoul10(content, &content));
+                        value = (size_t)strtoul10(content, &content);
                         // skip whitespace after it
                         SkipSpacesAndLineEnd(&content);
                     }
@@ -1732,9 +1722,8 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
 
     // It is possible to not contain any indices
     if (pNumPrimitives > 0) {
-        std::string v;
-        XmlParser::getValueAsString(node, v);
-        const char *content = v.c_str();
+        // parse the indices straight from the xml buffer, <p> elements may be huge
+        const char *content = node.text().as_string();
         SkipSpacesAndLineEnd(&content);
         while (*content != 0) {
             // read a value.
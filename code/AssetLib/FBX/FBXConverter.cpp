@@ -1121,32 +1121,22 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
     // to be present, or neither of them. Compute binormals from normals
     // and tangents if needed.
     const std::vector<aiVector3D> &tangents = mesh.GetTangents();
-    const std::vector<aiVector3D> *binormals = &mesh.GetBinormals();
+    const std::vector<aiVector3D> &binormals = mesh.GetBinormals();
 
-    if (tangents.size()) {
-        std::vector<aiVector3D> tempBinormals;
-        if (!binormals->size()) {
-            if (normals.size()) {
-                tempBinormals.resize(normals.size());
-                for (unsigned int i = 0; i < tangents.size(); ++i) {
-                    tempBinormals[i] = normals[i] ^ tangents[i];
-                }
-
-                binormals = &tempBinormals;
-            } else {
-                binormals = nullptr;
-            }
-        }
-
-        if (binormals) {
-            ai_assert(tangents.size() == vertices.size());
-            ai_assert(binormals->size() == vertices.size());
+    if (tangents.size() && (binormals.size() || normals.size())) {
+        ai_assert(tangents.size() == vertices.size());
 
-            out_mesh->mTangents = new aiVector3D[vertices.size()];
-            std::copy(tangents.begin(), tangents.end(), out_mesh->mTangents);
+        out_mesh->mTangents = new aiVector3D[vertices.size()];
+        std::copy(tangents.begin(), tangents.end(), out_mesh->mTangents);
 
-            out_mesh->mBitangents = new aiVector3D[vertices.size()];
-            std::copy(binormals->begin(), binormals->end(), out_mesh->mBitangents);
+        out_mesh->mBitangents = new aiVector3D[vertices.size()];
+        if (binormals.size()) {
+            ai_assert(binormals.size() == vertices.size());
+            std::copy(binormals.begin(), binormals.end(), out_mesh->mBitangents);
+        } else {
+            for (size_t i = 0; i < tangents.size(); ++i) {
+                out_mesh->mBitangents[i] = normals[i] ^ tangents[i];
+            }
         }
     }
 
@@ -1297,11 +1287,17 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
 
     // mapping from output indices to DOM indexing, needed to resolve weights or blendshapes
     std::vector<unsigned int> reverseMapping;
-    std::map<unsigned int, unsigned int> translateIndexMap;
     if (process_weights || mesh.GetBlendShapes().size() > 0) {
         reverseMapping.resize(count_vertices);
     }
 
+    // and the other way round, for blendshapes. Vertices not in this mesh are marked invalid.
+    static const unsigned int no_index_sentinel = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> translateIndexMap;
+    if (mesh.GetBlendShapes().size() > 0) {
+        translateIndexMap.resize(vertices.size(), no_index_sentinel);
+    }
+
     // allocate output data arrays, but don't fill them yet
     out_mesh->mNumVertices = count_vertices;
     out_mesh->mVertices = new aiVector3D[count_vertices];
@@ -1316,30 +1312,16 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         out_mesh->mNormals = new aiVector3D[count_vertices];
     }
 
-    // allocate tangents, binormals.
+    // allocate tangents, binormals. Missing binormals are computed from the normals
+    // on the fly, only for the vertices which make it into this mesh.
     const std::vector<aiVector3D> &tangents = mesh.GetTangents();
-    const std::vector<aiVector3D> *binormals = &mesh.GetBinormals();
-    std::vector<aiVector3D> tempBinormals;
+    const std::vector<aiVector3D> &binormals = mesh.GetBinormals();
+    const bool computeBinormals = binormals.empty();
 
     if (tangents.size()) {
-        if (!binormals->size()) {
-            if (normals.size()) {
-                // XXX this computes the binormals for the entire mesh, not only
-                // the part for which we need them.
-                tempBinormals.resize(normals.size());
-                for (unsigned int i = 0; i < tangents.size(); ++i) {
-                    tempBinormals[i] = normals[i] ^ tangents[i];
-                }
-
-                binormals = &tempBinormals;
-            } else {
-                binormals = nullptr;
-            }
-        }
-
-        if (binormals) {
+        if (!computeBinormals || normals.size()) {
             ai_assert(tangents.size() == vertices.size());
-            ai_assert(binormals->size() == vertices.size());
+            ai_assert(computeBinormals || binormals.size() == vertices.size());
 
             out_mesh->mTangents = new aiVector3D[count_vertices];
             out_mesh->mBitangents = new aiVector3D[count_vertices];
@@ -1402,6 +1384,8 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
 
             if (reverseMapping.size()) {
                 reverseMapping[cursor] = in_cursor;
+            }
+            if (translateIndexMap.size()) {
                 translateIndexMap[in_cursor] = cursor;
             }
 
@@ -1413,7 +1397,7 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
 
             if (out_mesh->mTangents) {
                 out_mesh->mTangents[cursor] = tangents[in_cursor];
-                out_mesh->mBitangents[cursor] = (*binormals)[in_cursor];
+                out_mesh->mBitangents[cursor] = computeBinormals ? normals[in_cursor] ^ tangents[in_cursor] : binormals[in_cursor];
             }
 
             for (unsigned int j = 0; j < num_uvs; ++j) {
@@ -1451,10 +1435,9 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
                     unsigned int count = 0;
                     const unsigned int *outIndices = mesh.ToOutputVertexIndex(curIndex, count);
                     for (unsigned int k = 0; k < count; k++) {
-                        unsigned int outIndex = outIndices[k];
-                        if (translateIndexMap.find(outIndex) == translateIndexMap.end())
+                        unsigned int transIndex = translateIndexMap[outIndices[k]];
+                        if (transIndex == no_index_sentinel)
                             continue;
-                        unsigned int transIndex = translateIndexMap[outIndex];
                         animMesh->mVertices[transIndex] += vertex;
                         if (animMesh->mNormals != nullptr) {
                             animMesh->mNormals[transIndex] += normal;
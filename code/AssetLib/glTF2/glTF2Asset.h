@@ -561,6 +561,7 @@ struct Accessor : public Object {
     ComponentType componentType; //!< The datatype of components in the attribute. (required)
     size_t count; //!< The number of attributes referenced by this accessor. (required)
     AttribType::Value type; //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+    bool normalized = false; //!< Specifies whether integer data values are normalized.
     std::vector<double> max; //!< Maximum value of each component in this attribute.
     std::vector<double> min; //!< Minimum value of each component in this attribute.
     std::unique_ptr<Sparse> sparse;
@@ -1136,6 +1137,7 @@ public:
         bool KHR_draco_mesh_compression;
         bool FB_ngon_encoding;
         bool KHR_texture_basisu;
+        bool KHR_mesh_quantization;
 
         Extensions() :
                 KHR_materials_pbrSpecularGlossiness(false), 
@@ -1151,7 +1153,8 @@ public:
                 KHR_materials_emissive_strength(false),
                 KHR_draco_mesh_compression(false),
                 FB_ngon_encoding(false),
-                KHR_texture_basisu(false) {
+                KHR_texture_basisu(false),
+                KHR_mesh_quantization(false) {
             // empty
         }
     } extensionsUsed;
@@ -1160,8 +1163,9 @@ public:
     struct RequiredExtensions {
         bool KHR_draco_mesh_compression;
         bool KHR_texture_basisu;
+        bool KHR_mesh_quantization;
 
-        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false) {
+        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false), KHR_mesh_quantization(false) {
             // empty
         }
     } extensionsRequired;
@@ -115,6 +115,9 @@ namespace glTF2 {
         obj.AddMember("componentType", int(a.componentType), w.mAl);
         obj.AddMember("count", (unsigned int)a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
         Value vTmpMax, vTmpMin;
         if (a.componentType == ComponentType_FLOAT) {
             obj.AddMember("max", MakeValue(vTmpMax, a.max, w.mAl), w.mAl);
@@ -1023,6 +1026,10 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_texture_basisu) {
                 exts.PushBack(StringRef("KHR_texture_basisu"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+                exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            }
         }
 
         if (!exts.Empty())
@@ -1031,8 +1038,13 @@ namespace glTF2 {
         //basisu extensionRequired
         Value extsReq;
         extsReq.SetArray();
-        if (this->mAsset.extensionsUsed.KHR_texture_basisu) {
+        if (this->mAsset.extensionsRequired.KHR_texture_basisu) {
             extsReq.PushBack(StringRef("KHR_texture_basisu"), mAl);
+        }
+        if (this->mAsset.extensionsRequired.KHR_mesh_quantization) {
+            extsReq.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+        }
+        if (!extsReq.Empty()) {
             mDoc.AddMember("extensionsRequired", extsReq, mAl);
         }
     }
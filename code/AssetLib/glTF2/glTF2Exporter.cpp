@@ -57,7 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOSystem.hpp>
 
 // Header files, standard library.
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
 #include <limits>
 #include <memory>
 
@@ -427,6 +429,67 @@ inline Ref<Accessor> ExportData(Asset &a, std::string &meshName, Ref<Buffer> &bu
     return acc;
 }
 
+// Writes integer vertex data which is normalized on reading, see KHR_mesh_quantization.
+// The elements of vertex attributes must be aligned to four bytes, so typeIn may have
+// more components than typeOut to pad the data.
+inline Ref<Accessor> ExportNormalizedData(Asset &a, std::string &meshName, Ref<Buffer> &buffer,
+        size_t count, void *data, AttribType::Value typeIn, AttribType::Value typeOut, ComponentType compType) {
+    if (!count || !data) {
+        return Ref<Accessor>();
+    }
+
+    unsigned int numCompsIn = AttribType::GetNumComponents(typeIn);
+    unsigned int numCompsOut = AttribType::GetNumComponents(typeOut);
+    unsigned int bytesPerComp = ComponentTypeSize(compType);
+    unsigned int stride = numCompsIn * bytesPerComp;
+    ai_assert(stride % 4 == 0);
+
+    size_t offset = buffer->byteLength;
+    size_t padding = (4 - offset % 4) % 4;
+    offset += padding;
+    size_t length = count * stride;
+    buffer->Grow(length + padding);
+
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    bv->buffer = buffer;
+    bv->byteOffset = offset;
+    bv->byteLength = length;
+    bv->byteStride = numCompsIn != numCompsOut ? stride : 0;
+    bv->target = BufferViewTarget_ARRAY_BUFFER;
+
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->bufferView = bv;
+    acc->byteOffset = 0;
+    acc->componentType = compType;
+    acc->count = count;
+    acc->type = typeOut;
+    acc->normalized = true;
+
+    SetAccessorRange(compType, acc, data, count, numCompsIn, numCompsOut);
+    memcpy(buffer->GetPointer() + offset, data, length);
+
+    return acc;
+}
+
+// Quantizes values in [-1,1] or [0,1] to normalized integers of type T, returns false if
+// a value is out of range.
+template <typename T, typename TReal>
+bool QuantizeNormalized(const TReal *values, size_t count, size_t numCompsIn, size_t numCompsOut, std::vector<T> &out) {
+    const float max = static_cast<float>(std::numeric_limits<T>::max());
+    const float min = std::numeric_limits<T>::is_signed ? -1.f : 0.f;
+    out.assign(count * numCompsOut, 0);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t c = 0; c < std::min(numCompsIn, numCompsOut); ++c) {
+            const float value = static_cast<float>(values[i * numCompsIn + c]);
+            if (!(value >= min && value <= 1.f)) {
+                return false;
+            }
+            out[i * numCompsOut + c] = static_cast<T>(std::round(value * max));
+        }
+    }
+    return true;
+}
+
 inline void ExportNodeExtras(const aiMetadataEntry &metadataEntry, aiString name, CustomExtension &value) {
 
     value.name = name.C_Str();
@@ -1169,6 +1232,10 @@ void glTF2Exporter::ExportMeshes() {
     }
     //----------------------------------------
 
+    const bool quantize = mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE_ATTRIBUTES);
+    std::vector<int8_t> quantized8;
+    std::vector<uint16_t> quantized16;
+
     for (unsigned int idx_mesh = 0; idx_mesh < mScene->mNumMeshes; ++idx_mesh) {
         const aiMesh *aim = mScene->mMeshes[idx_mesh];
 
@@ -1199,8 +1266,15 @@ void glTF2Exporter::ExportMeshes() {
             }
         }
 
-        Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3,
-                AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+        Ref<Accessor> n;
+        if (quantize && nullptr != aim->mNormals && QuantizeNormalized(&aim->mNormals->x, aim->mNumVertices, 3, 4, quantized8)) {
+            n = ExportNormalizedData(*mAsset, meshId, b, aim->mNumVertices, quantized8.data(), AttribType::VEC4,
+                    AttribType::VEC3, ComponentType_BYTE);
+            mAsset->extensionsUsed.KHR_mesh_quantization = mAsset->extensionsRequired.KHR_mesh_quantization = true;
+        } else {
+            n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3,
+                    AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+        }
         if (n) {
             p.attributes.normal.push_back(n);
         }
@@ -1221,8 +1295,16 @@ void glTF2Exporter::ExportMeshes() {
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-                Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i],
-                        AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+                Ref<Accessor> tc;
+                if (quantize && type == AttribType::VEC2 &&
+                        QuantizeNormalized(&aim->mTextureCoords[i]->x, aim->mNumVertices, 3, 2, quantized16)) {
+                    tc = ExportNormalizedData(*mAsset, meshId, b, aim->mNumVertices, quantized16.data(), AttribType::VEC2,
+                            AttribType::VEC2, ComponentType_UNSIGNED_SHORT);
+                    mAsset->extensionsUsed.KHR_mesh_quantization = mAsset->extensionsRequired.KHR_mesh_quantization = true;
+                } else {
+                    tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i],
+                            AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+                }
                 if (tc) {
                     p.attributes.texcoord.push_back(tc);
                 }
@@ -1231,8 +1313,15 @@ void glTF2Exporter::ExportMeshes() {
 
         /*************** Vertex colors ****************/
         for (unsigned int indexColorChannel = 0; indexColorChannel < aim->GetNumColorChannels(); ++indexColorChannel) {
-            Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel],
-                    AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+            // normalized colors are part of the core spec
+            Ref<Accessor> c;
+            if (quantize && QuantizeNormalized(&aim->mColors[indexColorChannel]->r, aim->mNumVertices, 4, 4, quantized16)) {
+                c = ExportNormalizedData(*mAsset, meshId, b, aim->mNumVertices, quantized16.data(), AttribType::VEC4,
+                        AttribType::VEC4, ComponentType_UNSIGNED_SHORT);
+            } else {
+                c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel],
+                        AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+            }
             if (c) {
                 p.attributes.color.push_back(c);
             }
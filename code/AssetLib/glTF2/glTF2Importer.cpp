@@ -460,6 +460,57 @@ aiColor4D *GetVertexColorsForType(Ref<Accessor> input, std::vector<unsigned int>
     return output;
 }
 
+// Converts integer vertex data to ai_reals. Normalized values are mapped to [0,1] or
+// [-1,1] as defined by the spec, plain integers are taken as they are.
+template <typename T>
+void ConvertIntegerData(Ref<Accessor> input, std::vector<unsigned int> *vertexRemappingTable, ai_real *output, size_t outputStride) {
+    struct Element {
+        T values[4];
+    };
+    Element *elements = nullptr;
+    const size_t count = input->ExtractData(elements, vertexRemappingTable);
+    const unsigned int numComponents = std::min(input->GetNumComponents(), static_cast<unsigned int>(outputStride));
+    const ai_real max = static_cast<ai_real>(std::numeric_limits<T>::max());
+    for (size_t i = 0; i < count; ++i) {
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            const ai_real value = static_cast<ai_real>(elements[i].values[c]);
+            output[i * outputStride + c] = input->normalized ? std::max(value / max, static_cast<ai_real>(-1)) : value;
+        }
+    }
+    delete[] elements;
+}
+
+// Extracts vertex data into an array of T, which must consist of ai_reals only. Besides floats,
+// integer data is accepted as well, it is used by KHR_mesh_quantization.
+template <typename T>
+size_t ExtractVertexData(Ref<Accessor> input, T *&output, std::vector<unsigned int> *vertexRemappingTable) {
+    if (input->componentType == ComponentType_FLOAT) {
+        return input->ExtractData(output, vertexRemappingTable);
+    }
+
+    const size_t count = vertexRemappingTable != nullptr ? vertexRemappingTable->size() : input->count;
+    output = new T[count]();
+    ai_real *values = reinterpret_cast<ai_real *>(output);
+    const size_t stride = sizeof(T) / sizeof(ai_real);
+    switch (input->componentType) {
+    case ComponentType_BYTE:
+        ConvertIntegerData<int8_t>(input, vertexRemappingTable, values, stride);
+        break;
+    case ComponentType_UNSIGNED_BYTE:
+        ConvertIntegerData<uint8_t>(input, vertexRemappingTable, values, stride);
+        break;
+    case ComponentType_SHORT:
+        ConvertIntegerData<int16_t>(input, vertexRemappingTable, values, stride);
+        break;
+    case ComponentType_UNSIGNED_SHORT:
+        ConvertIntegerData<uint16_t>(input, vertexRemappingTable, values, stride);
+        break;
+    default:
+        throw DeadlyImportError("GLTF: unsupported component type ", input->componentType, " for vertex data in ", input->id);
+    }
+    return count;
+}
+
 void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
     ASSIMP_LOG_DEBUG("Importing ", r.meshes.Size(), " meshes");
     std::vector<std::unique_ptr<aiMesh>> meshes;
@@ -561,14 +612,14 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
             }
 
             if (!attr.position.empty() && attr.position[0]) {
-                aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->ExtractData(aim->mVertices, vertexRemappingTable));
+                aim->mNumVertices = static_cast<unsigned int>(ExtractVertexData(attr.position[0], aim->mVertices, vertexRemappingTable));
             }
 
             if (!attr.normal.empty() && attr.normal[0]) {
                     if (attr.normal[0]->count != numAllVertices) {
                     DefaultLogger::get()->warn("Normal count in mesh \"", mesh.name, "\" does not match the vertex count, normals ignored.");
                 } else {
-                    attr.normal[0]->ExtractData(aim->mNormals, vertexRemappingTable);
+                    ExtractVertexData(attr.normal[0], aim->mNormals, vertexRemappingTable);
 
                     // only extract tangents if normals are present
                     if (!attr.tangent.empty() && attr.tangent[0]) {
@@ -578,7 +629,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                             // generate bitangents from normals and tangents according to spec
                             Tangent *tangents = nullptr;
 
-                            attr.tangent[0]->ExtractData(tangents, vertexRemappingTable);
+                            ExtractVertexData(attr.tangent[0], tangents, vertexRemappingTable);
 
                             aim->mTangents = new aiVector3D[aim->mNumVertices];
                             aim->mBitangents = new aiVector3D[aim->mNumVertices];
@@ -624,7 +675,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     continue;
                 }
 
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc], vertexRemappingTable);
+                ExtractVertexData(attr.texcoord[tc], aim->mTextureCoords[tc], vertexRemappingTable);
                 aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
 
                 aiVector3D *values = aim->mTextureCoords[tc];
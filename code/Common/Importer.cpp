@@ -89,6 +89,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 #   include "PostProcessing/ValidateDataStructure.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+#   include "PostProcessing/GenLODsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+#   include "PostProcessing/GenMeshletsProcess.h"
+#endif
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+#   include "PostProcessing/GenBVHProcess.h"
+#endif
 
 using namespace Assimp::Profiling;
 using namespace Assimp::Formatter;
@@ -795,8 +804,23 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         return nullptr;
     }
 
+    // The steps without a flag of their own are enabled by their config property alone
+    bool bPropertySteps = false;
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+    const bool bGenLODs = GetPropertyInteger(AI_CONFIG_PP_GLOD_LEVELS, 0) > 0;
+    bPropertySteps |= bGenLODs;
+#endif // no LOD generation
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+    const bool bGenMeshlets = GetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_VERTICES, 0) > 0;
+    bPropertySteps |= bGenMeshlets;
+#endif // no meshlet generation
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+    const bool bGenBVH = GetPropertyBool(AI_CONFIG_PP_GBVH_SCENE, false) || GetPropertyBool(AI_CONFIG_PP_GBVH_MESHES, false);
+    bPropertySteps |= bGenBVH;
+#endif // no BVH generation
+
     // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    if (!pFlags && !bPropertySteps) {
         return pimpl->mScene;
     }
 
@@ -866,6 +890,28 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         }
 #endif // ! DEBUG
     }
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+    // There is no flag left for the LOD generation, it is enabled through its config
+    // property and runs last so the levels are built from the final meshes.
+    if (pimpl->mScene && bGenLODs) {
+        GenLODsProcess lods;
+        lods.ExecuteOnScene(this);
+    }
+#endif // no LOD generation
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+    // Same for the meshlets, which are built for the LODs as well
+    if (pimpl->mScene && bGenMeshlets) {
+        GenMeshletsProcess meshlets;
+        meshlets.ExecuteOnScene(this);
+    }
+#endif // no meshlet generation
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+    // The BVHs come last, they reference the final faces and node graph
+    if (pimpl->mScene && bGenBVH) {
+        GenBVHProcess bvh;
+        bvh.ExecuteOnScene(this);
+    }
+#endif // no BVH generation
     pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()),
         static_cast<int>(pimpl->mPostProcessingSteps.size()) );
 
@@ -62,6 +62,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/metadata.h>
 #include <assimp/scene.h>
 #include <stdio.h>
+#include <unordered_map>
 #include <assimp/DefaultLogger.hpp>
 
 namespace Assimp {
@@ -674,31 +675,30 @@ void SceneCombiner::MergeScenes(aiScene **_dest, aiScene *master, std::vector<At
 void SceneCombiner::BuildUniqueBoneList(std::list<BoneWithHash> &asBones,
         std::vector<aiMesh *>::const_iterator it,
         std::vector<aiMesh *>::const_iterator end) {
+    // index the bones by their hash, so each lookup is constant
+    // time instead of a walk over the whole list
+    std::unordered_map<uint32_t, BoneWithHash *> index;
+    for (BoneWithHash &bone : asBones) {
+        index.emplace(bone.first, &bone);
+    }
+
     unsigned int iOffset = 0;
     for (; it != end; ++it) {
         for (unsigned int l = 0; l < (*it)->mNumBones; ++l) {
             aiBone *p = (*it)->mBones[l];
             uint32_t itml = SuperFastHash(p->mName.data, (unsigned int)p->mName.length);
 
-            std::list<BoneWithHash>::iterator it2 = asBones.begin();
-            std::list<BoneWithHash>::iterator end2 = asBones.end();
-
-            for (; it2 != end2; ++it2) {
-                if ((*it2).first == itml) {
-                    (*it2).pSrcBones.emplace_back(p, iOffset);
-                    break;
-                }
-            }
-            if (end2 == it2) {
+            BoneWithHash *&entry = index[itml];
+            if (nullptr == entry) {
                 // need to begin a new bone entry
                 asBones.emplace_back();
-                BoneWithHash &btz = asBones.back();
+                entry = &asBones.back();
 
                 // setup members
-                btz.first = itml;
-                btz.second = &p->mName;
-                btz.pSrcBones.emplace_back(p, iOffset);
+                entry->first = itml;
+                entry->second = &p->mName;
             }
+            entry->pSrcBones.emplace_back(p, iOffset);
         }
         iOffset += (*it)->mNumVertices;
     }
@@ -1053,6 +1053,9 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
     // now - copy the root node of the scene (deep copy, too)
     Copy(&dest->mRootNode, src->mRootNode);
 
+    // the instance numbering of the BVH stays valid for the copied node graph
+    Copy(&dest->mBVH, src->mBVH);
+
     // and keep the flags ...
     dest->mFlags = src->mFlags;
 
@@ -1102,6 +1105,9 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     // make a deep copy of all blend shapes
     CopyPtrArray(dest->mAnimMeshes, dest->mAnimMeshes, dest->mNumAnimMeshes);
 
+    GetArrayCopy(dest->mMeshlets, dest->mNumMeshlets);
+    Copy(&dest->mBVH, src->mBVH);
+
     // make a deep copy of all texture coordinate names
     if (src->mTextureCoordsNames != nullptr) {
         dest->mTextureCoordsNames = new aiString *[AI_MAX_NUMBER_OF_TEXTURECOORDS] {};
@@ -1111,6 +1117,23 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::Copy(aiBVH **_dest, const aiBVH *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiBVH *dest = *_dest = new aiBVH();
+
+    dest->mNumNodes = src->mNumNodes;
+    dest->mNodes = src->mNodes;
+    GetArrayCopy(dest->mNodes, dest->mNumNodes);
+
+    dest->mNumPrimitives = src->mNumPrimitives;
+    dest->mPrimitives = src->mPrimitives;
+    GetArrayCopy(dest->mPrimitives, dest->mNumPrimitives);
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy(aiAnimMesh **_dest, const aiAnimMesh *src) {
     if (nullptr == _dest || nullptr == src) {
@@ -50,12 +50,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 
-#include <unordered_map>
+#include <algorithm>
 
 using namespace Assimp;
 
-void mydummy() {}
-
 #ifdef _MSC_VER
 #pragma warning(disable : 4709)
 #endif // _MSC_VER
@@ -81,25 +79,7 @@ public:
     };
 
     typedef std::vector<unsigned int> UIntVector;
-    typedef std::unordered_map<uint64_t, Edge> EdgeMap;
-
-    // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
-    // 'unsigned int' vertex coordinates (!!distinct coordinates - same
-    // vertex position == same index!!).
-    // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-    // and (id[0]>2^32-1 or id[0]>2^32-1).
-    // MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-    // at the head of every function which is about to use MAKE_EDGE_HASH().
-    // Reason is that the hash is that hash construction needs to hold the
-    // invariant id0<id1 to identify an edge - else two hashes would refer
-    // to the same edge.
-    // ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0, id1) (eh_tmp0__ = id0, eh_tmp1__ = id1, \
-        (eh_tmp0__ < eh_tmp1__ ? std::swap(eh_tmp0__, eh_tmp1__) : mydummy()), (uint64_t)eh_tmp0__ ^ ((uint64_t)eh_tmp1__ << 32u))
-
-#define INIT_EDGE_HASH_TEMPORARIES() \
-    unsigned int eh_tmp0__, eh_tmp1__;
+    typedef std::vector<Edge> EdgeVector;
 
 private:
     void InternSubdivide(const aiMesh *const *smesh,
@@ -144,6 +124,30 @@ void CatmullClarkSubdivider::Subdivide(
 
     // course, both regions may not overlap
     ai_assert(smesh < out || smesh + nmesh > out + nmesh);
+
+    // Respect the face budget, if any. Each subdivision step turns every face
+    // into one quad per corner, each further step quadruples the face count.
+    // All meshes are refined by the same number of steps to avoid cracks.
+    if (num && mFaceBudget) {
+        uint64_t faces = 0;
+        for (size_t s = 0; s < nmesh; ++s) {
+            const aiMesh *i = smesh[s];
+            for (unsigned int a = 0; a < i->mNumFaces; ++a) {
+                faces += i->mFaces[a].mNumIndices;
+            }
+        }
+
+        unsigned int levels = 0;
+        for (; levels < num && faces <= mFaceBudget; ++levels) {
+            faces <<= 2u;
+        }
+        if (levels < num) {
+            ASSIMP_LOG_WARN("Catmull-Clark Subdivider: Face budget of ", mFaceBudget, " allows only ",
+                    levels, " of ", num, " subdivision steps");
+            num = levels;
+        }
+    }
+
     if (!num) {
         // No subdivision at all. Need to copy all the meshes .. argh.
         if (discard_input) {
@@ -231,8 +235,6 @@ void CatmullClarkSubdivider::InternSubdivide(
     ai_assert(nullptr != smesh);
     ai_assert(nullptr != out);
 
-    INIT_EDGE_HASH_TEMPORARIES();
-
     // no subdivision requested or end of recursive refinement
     if (!num) {
         return;
@@ -265,9 +267,12 @@ void CatmullClarkSubdivider::InternSubdivide(
 #define FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first + face_idx)
 
     // ---------------------------------------------------------------------
-    // 1. Compute the centroid point for all faces
+    // 1. Compute the centroid point for all faces. Also record the offset
+    // of the first corner of each face and the mesh each face belongs to,
+    // so that corners and faces can be addressed globally.
     // ---------------------------------------------------------------------
     std::vector<Vertex> centroids(totfaces);
+    UIntVector faceofs(totfaces + 1), facemesh(totfaces);
     unsigned int nfacesout = 0;
     for (size_t t = 0, n = 0; t < nmesh; ++t) {
         const aiMesh *mesh = smesh[t];
@@ -280,16 +285,77 @@ void CatmullClarkSubdivider::InternSubdivide(
             }
 
             c /= static_cast<float>(face.mNumIndices);
+            faceofs[n] = nfacesout;
+            facemesh[n] = static_cast<unsigned int>(t);
             nfacesout += face.mNumIndices;
         }
     }
+    faceofs[totfaces] = nfacesout;
+
+#define NEXT_CORNER(face, a) ((a) == (face).mNumIndices - 1 ? 0 : (a) + 1)
+#define PREV_CORNER(face, a) (!(a) ? (face).mNumIndices - 1 : (a) - 1)
 
     {
         // we want edges to go away before the recursive calls so begin a new scope
-        EdgeMap edges;
+        EdgeVector edges;
+
+        // ---------------------------------------------------------------------
+        // 2. Build the edge topology. Edges are identified by their distinct
+        // end points and are bucketed by the lower one in a compressed
+        // (CSR) table. Every face corner receives the index of the edge
+        // leading to the next corner, so no further lookups are needed.
+        // ---------------------------------------------------------------------
+        UIntVector cornedge(nfacesout);
+        {
+            UIntVector bucketofs(num_unique + 1, 0), bucketcnt(num_unique, 0);
+            for (size_t t = 0; t < nmesh; ++t) {
+                const aiMesh *mesh = smesh[t];
+                for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                    const aiFace &face = mesh->mFaces[i];
+                    for (unsigned int p = 0; p < face.mNumIndices; ++p) {
+                        const unsigned int mp0 = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[p])];
+                        const unsigned int mp1 = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[NEXT_CORNER(face, p)])];
+                        ++bucketofs[std::min(mp0, mp1) + 1];
+                    }
+                }
+            }
+            for (unsigned int i = 0; i < num_unique; ++i) {
+                bucketofs[i + 1] += bucketofs[i];
+            }
+
+            // (higher end point, edge index) for all edges starting at a vertex
+            std::vector<IntPair> buckets(nfacesout);
+            unsigned int numedges = 0;
+            for (size_t t = 0; t < nmesh; ++t) {
+                const aiMesh *mesh = smesh[t];
+                for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+                    const aiFace &face = mesh->mFaces[i];
+                    const unsigned int c = faceofs[FLATTEN_FACE_IDX(t, i)];
+                    for (unsigned int p = 0; p < face.mNumIndices; ++p) {
+                        const unsigned int mp0 = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[p])];
+                        const unsigned int mp1 = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[NEXT_CORNER(face, p)])];
+                        const unsigned int lo = std::min(mp0, mp1), hi = std::max(mp0, mp1);
+
+                        IntPair *const bucket = &buckets[bucketofs[lo]];
+                        unsigned int &cnt = bucketcnt[lo];
+                        unsigned int b = 0;
+                        while (b < cnt && bucket[b].first != hi) {
+                            ++b;
+                        }
+                        if (b == cnt) {
+                            bucket[cnt++] = IntPair(hi, numedges++);
+                        }
+                        cornedge[c + p] = bucket[b].second;
+                    }
+                }
+            }
+            edges.resize(numedges);
+        }
+
+#define CORNER_EDGE(face_idx, a) (edges[cornedge[faceofs[face_idx] + (a)]])
 
         // ---------------------------------------------------------------------
-        // 2. Set each edge point to be the average of all neighbouring
+        // 3. Set each edge point to be the average of all neighbouring
         // face points and original points. Every edge exists twice
         // if there is a neighboring face.
         // ---------------------------------------------------------------------
@@ -300,20 +366,12 @@ void CatmullClarkSubdivider::InternSubdivide(
                 const aiFace &face = mesh->mFaces[i];
 
                 for (unsigned int p = 0; p < face.mNumIndices; ++p) {
-                    const unsigned int id[] = {
-                        face.mIndices[p],
-                        face.mIndices[p == face.mNumIndices - 1 ? 0 : p + 1]
-                    };
-                    const unsigned int mp[] = {
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[0])],
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[1])]
-                    };
-
-                    Edge &e = edges[MAKE_EDGE_HASH(mp[0], mp[1])];
+                    Edge &e = CORNER_EDGE(FLATTEN_FACE_IDX(t, i), p);
                     e.ref++;
                     if (e.ref <= 2) {
                         if (e.ref == 1) { // original points (end points) - add only once
-                            e.edge_point = e.midpoint = Vertex(mesh, id[0]) + Vertex(mesh, id[1]);
+                            e.edge_point = e.midpoint = Vertex(mesh, face.mIndices[p]) +
+                                    Vertex(mesh, face.mIndices[NEXT_CORNER(face, p)]);
                             e.midpoint *= 0.5f;
                         }
                         e.edge_point += centroids[FLATTEN_FACE_IDX(t, i)];
@@ -323,16 +381,16 @@ void CatmullClarkSubdivider::InternSubdivide(
         }
 
         // ---------------------------------------------------------------------
-        // 3. Normalize edge points
+        // 4. Normalize edge points
         // ---------------------------------------------------------------------
         {
             unsigned int bad_cnt = 0;
-            for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-                if ((*it).second.ref < 2) {
-                    ai_assert((*it).second.ref);
+            for (Edge &e : edges) {
+                if (e.ref < 2) {
+                    ai_assert(e.ref);
                     ++bad_cnt;
                 }
-                (*it).second.edge_point *= 1.f / ((*it).second.ref + 2.f);
+                e.edge_point *= 1.f / (e.ref + 2.f);
             }
 
             if (bad_cnt) {
@@ -345,7 +403,7 @@ void CatmullClarkSubdivider::InternSubdivide(
         }
 
         // ---------------------------------------------------------------------
-        // 4. Compute a vertex-face adjacency table. We can't reuse the code
+        // 5. Compute a vertex-face adjacency table. We can't reuse the code
         // from VertexTriangleAdjacency because we need the table for multiple
         // meshes and out vertex indices need to be mapped to distinct values
         // first.
@@ -385,26 +443,21 @@ void CatmullClarkSubdivider::InternSubdivide(
                 for (unsigned int m = 0; m < cntadjfac[t]; ++m) {
                     const unsigned int fidx = faceadjac[ofsadjvec[t] + m];
                     ai_assert(fidx < totfaces);
-                    for (size_t n = 1; n < nmesh; ++n) {
 
-                        if (moffsets[n].first > fidx) {
-                            const aiMesh *msh = smesh[--n];
-                            const aiFace &f = msh->mFaces[fidx - moffsets[n].first];
+                    const unsigned int n = facemesh[fidx];
+                    const aiFace &f = smesh[n]->mFaces[fidx - moffsets[n].first];
 
-                            bool haveit = false;
-                            for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(n, f.mIndices[i])] == (unsigned int)t) {
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-                            ai_assert(haveit);
-                            if (!haveit) {
-                                ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: Index not used");
-                            }
+                    bool haveit = false;
+                    for (unsigned int i = 0; i < f.mNumIndices; ++i) {
+                        if (maptbl[FLATTEN_VERTEX_IDX(n, f.mIndices[i])] == (unsigned int)t) {
+                            haveit = true;
                             break;
                         }
                     }
+                    ai_assert(haveit);
+                    if (!haveit) {
+                        ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: Index not used");
+                    }
                 }
             }
 
@@ -417,7 +470,7 @@ void CatmullClarkSubdivider::InternSubdivide(
         typedef std::pair<bool, Vertex> TouchedOVertex;
         std::vector<TouchedOVertex> new_points(num_unique, TouchedOVertex(false, Vertex()));
         // ---------------------------------------------------------------------
-        // 5. Spawn a quad from each face point to the corresponding edge points
+        // 6. Spawn a quad from each face point to the corresponding edge points
         // the original points being the fourth quad points.
         // ---------------------------------------------------------------------
         for (size_t t = 0; t < nmesh; ++t) {
@@ -471,12 +524,10 @@ void CatmullClarkSubdivider::InternSubdivide(
                     centroids[FLATTEN_FACE_IDX(t, i)].SortBack(mout, faceOut.mIndices[0] = v++);
 
                     // b) adjacent edge on the left, seen from the centroid
-                    const Edge &e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a == face.mNumIndices - 1 ? 0 : a + 1])])]; // fixme: replace with mod face.mNumIndices?
+                    const Edge &e0 = CORNER_EDGE(FLATTEN_FACE_IDX(t, i), a);
 
                     // c) adjacent edge on the right, seen from the centroid
-                    const Edge &e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[!a ? face.mNumIndices - 1 : a - 1])])]; // fixme: replace with mod face.mNumIndices?
+                    const Edge &e1 = CORNER_EDGE(FLATTEN_FACE_IDX(t, i), PREV_CORNER(face, a));
 
                     e0.edge_point.SortBack(mout, faceOut.mIndices[3] = v++);
                     e1.edge_point.SortBack(mout, faceOut.mIndices[1] = v++);
@@ -510,20 +561,9 @@ void CatmullClarkSubdivider::InternSubdivide(
                                 ai_assert(adj[o] < totfaces);
                                 F += centroids[adj[o]];
 
-                                // adj[0] is a global face index - search the face in the mesh list
-                                const aiMesh *mp = nullptr;
-                                size_t nidx;
-
-                                if (adj[o] < moffsets[0].first) {
-                                    mp = smesh[nidx = 0];
-                                } else {
-                                    for (nidx = 1; nidx <= nmesh; ++nidx) {
-                                        if (nidx == nmesh || moffsets[nidx].first > adj[o]) {
-                                            mp = smesh[--nidx];
-                                            break;
-                                        }
-                                    }
-                                }
+                                // adj[0] is a global face index - look up the mesh it belongs to
+                                const size_t nidx = facemesh[adj[o]];
+                                const aiMesh *mp = smesh[nidx];
 
                                 ai_assert(adj[o] - moffsets[nidx].first < mp->mNumFaces);
                                 const aiFace &f = mp->mFaces[adj[o] - moffsets[nidx].first];
@@ -539,13 +579,8 @@ void CatmullClarkSubdivider::InternSubdivide(
                                         // factor 2.f in the amove formula and get the right
                                         // result.
 
-                                        const Edge &c0 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[!m ? f.mNumIndices - 1 : m - 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
-
-                                        const Edge &c1 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[m == f.mNumIndices - 1 ? 0 : m + 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
+                                        const Edge &c0 = CORNER_EDGE(adj[o], PREV_CORNER(f, m));
+                                        const Edge &c1 = CORNER_EDGE(adj[o], m);
                                         R += c0.midpoint + c1.midpoint;
 
                                         haveit = true;
@@ -556,7 +591,7 @@ void CatmullClarkSubdivider::InternSubdivide(
                                 // this invariant *must* hold if the vertex-to-face adjacency table is valid
                                 ai_assert(haveit);
                                 if (!haveit) {
-                                    ASSIMP_LOG_WARN("OBJ: no name for material library specified.");
+                                    ASSIMP_LOG_WARN("Catmull-Clark Subdivider: Vertex not found in adjacent face");
                                 }
                             }
 
@@ -570,6 +605,10 @@ void CatmullClarkSubdivider::InternSubdivide(
         }
     } // end of scope for edges, freeing its memory
 
+#undef CORNER_EDGE
+#undef NEXT_CORNER
+#undef PREV_CORNER
+
     // ---------------------------------------------------------------------
     // 7. Apply the next subdivision step.
     // ---------------------------------------------------------------------
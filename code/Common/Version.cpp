@@ -138,6 +138,7 @@ ASSIMP_API aiScene::aiScene() :
         mName(),
         mNumSkeletons(0),
         mSkeletons(nullptr),
+        mBVH(nullptr),
         mPrivate(new Assimp::ScenePrivateData()) {
     // empty
 }
@@ -196,5 +197,7 @@ ASSIMP_API aiScene::~aiScene() {
 
     delete[] mSkeletons;
 
+    delete mBVH;
+
     delete static_cast<Assimp::ScenePrivateData *>(mPrivate);
 }
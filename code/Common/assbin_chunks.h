@@ -2,7 +2,7 @@
 #define INCLUDED_ASSBIN_CHUNKS_H
 
 #define ASSBIN_VERSION_MAJOR 1
-#define ASSBIN_VERSION_MINOR 0
+#define ASSBIN_VERSION_MINOR 1
 
 /**
 @page assfile .ASS File formats
@@ -72,7 +72,9 @@ byte[44]    Magic identification string for ASSBIN files.
 
 integer     Major version of the Assimp library which wrote the file
 integer     Minor version of the Assimp library which wrote the file
-                match these against ASSBIN_VERSION_MAJOR and ASSBIN_VERSION_MINOR
+                match these against ASSBIN_VERSION_MAJOR and ASSBIN_VERSION_MINOR.
+                Minor version 1 added the ASSBIN_CHUNK_AIBVH chunks, readers
+                accept all minor versions up to their own.
 
 integer     SVN revision of the Assimp library (intended for our internal
             debugging - if you write Ass files from your own APPs, set this value to 0.
@@ -146,6 +148,21 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
      the kinds of vertex components actually present in the mesh. This is a
      bitwise combination of the ASSBIN_MESH_HAS_xxx constants.
 
+   - If ASSBIN_MESH_HAS_BVH is set, aiMesh::mBVH is stored in a
+     ASSBIN_CHUNK_AIBVH subchunk following the bones.
+
+[[aiScene]]
+
+   - aiScene::mBVH is stored in an optional ASSBIN_CHUNK_AIBVH subchunk
+     following the cameras. It is present if the size of the scene chunk
+     leaves room for it.
+
+[[aiBVH]]
+
+   - mNumNodes and mNumPrimitives come first, followed by mNodes written
+     as float mAABB.mMin[3], float mAABB.mMax[3], integer mOffset,
+     integer mNumPrimitives, followed by mPrimitives.
+
 [[aiFace]]
 
    - mNumIndices is stored as short
@@ -182,10 +199,12 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 #define ASSBIN_CHUNK_AINODE                     0x123c
 #define ASSBIN_CHUNK_AIMATERIAL                 0x123d
 #define ASSBIN_CHUNK_AIMATERIALPROPERTY         0x123e
+#define ASSBIN_CHUNK_AIBVH                      0x123f
 
 #define ASSBIN_MESH_HAS_POSITIONS                   0x1
 #define ASSBIN_MESH_HAS_NORMALS                     0x2
 #define ASSBIN_MESH_HAS_TANGENTS_AND_BITANGENTS     0x4
+#define ASSBIN_MESH_HAS_BVH                         0x8
 #define ASSBIN_MESH_HAS_TEXCOORD_BASE               0x100
 #define ASSBIN_MESH_HAS_COLOR_BASE                  0x10000
 
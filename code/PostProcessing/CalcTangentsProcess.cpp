@@ -53,6 +53,31 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Adds the tangent of another face to a shared vertex, invalid tangents are ignored
+static inline void AccumulateTangent(aiVector3D &sum, const aiVector3D &tangent) {
+    if (is_special_float(tangent.x) || is_special_float(tangent.y) || is_special_float(tangent.z)) {
+        return;
+    }
+    if (is_special_float(sum.x) || is_special_float(sum.y) || is_special_float(sum.z)) {
+        sum = tangent;
+    } else {
+        sum += tangent;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the angle of a polygon at one of its corners, the weight of its tangents for a shared vertex
+static float CornerAngle(const aiVector3D *meshPos, const aiFace &face, unsigned int corner) {
+    const aiVector3D &pos = meshPos[face.mIndices[corner]];
+    aiVector3D prev = meshPos[face.mIndices[(corner + face.mNumIndices - 1) % face.mNumIndices]] - pos;
+    aiVector3D next = meshPos[face.mIndices[(corner + 1) % face.mNumIndices]] - pos;
+    const float cosAngle = prev.NormalizeSafe() * next.NormalizeSafe();
+
+    // degenerated corners still get a tiny weight, so the sum can't vanish
+    return std::max(std::acos(std::max(-1.0f, std::min(1.0f, cosAngle))), 1e-6f);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 CalcTangentsProcess::CalcTangentsProcess() :
@@ -101,10 +126,10 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 // ------------------------------------------------------------------------------------------------
 // Calculates tangents and bi-tangents for the given mesh
 bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
-    // we assume that the mesh is still in the verbose vertex format where each face has its own set
-    // of vertices and no vertices are shared between faces. Sadly I don't know any quick test to
-    // assert() it here.
-    // assert( must be verbose, dammit);
+    // we expect the mesh to be still in the verbose vertex format where each face has its own set
+    // of vertices. Vertices which are nevertheless shared between faces receive the average of
+    // the face tangents weighted by the angle of the faces at the vertex, the index buffer tells
+    // us which ones these are.
 
     if (pMesh->mTangents) // this implies that mBitangents is also there
         return false;
@@ -130,6 +155,9 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
     const float angleEpsilon = 0.9999f;
 
     std::vector<bool> vertexDone(pMesh->mNumVertices, false);
+    std::vector<unsigned char> refs(pMesh->mNumVertices, 0);
+    std::vector<unsigned int> firstFace(pMesh->mNumVertices);
+    bool bSharedVertices = false;
     const float qnan = get_qnan();
 
     // create space for the tangents and bitangents
@@ -148,9 +176,13 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
         if (face.mNumIndices < 3) {
             // There are less than three indices, thus the tangent vector
             // is not defined. We are finished with these vertices now,
-            // their tangent vectors are set to qnan.
+            // their tangent vectors are set to qnan - unless a polygon
+            // references them as well.
             for (unsigned int i = 0; i < face.mNumIndices; ++i) {
                 unsigned int idx = face.mIndices[i];
+                if (refs[idx]) {
+                    continue;
+                }
                 vertexDone[idx] = true;
                 meshTang[idx] = aiVector3D(qnan);
                 meshBitang[idx] = aiVector3D(qnan);
@@ -213,8 +245,40 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
             }
 
             // and write it into the mesh.
-            meshTang[p] = localTangent;
-            meshBitang[p] = localBitangent;
+            if (!refs[p]) {
+                meshTang[p] = localTangent;
+                meshBitang[p] = localBitangent;
+                vertexDone[p] = false;
+                firstFace[p] = a;
+                refs[p] = 1;
+            } else {
+                // weight the tangents of the first face now that the vertex turns out to be shared
+                if (refs[p] == 1) {
+                    const aiFace &first = pMesh->mFaces[firstFace[p]];
+                    unsigned int corner = 0;
+                    while (first.mIndices[corner] != p) {
+                        ++corner;
+                    }
+                    const float firstWeight = CornerAngle(meshPos, first, corner);
+                    meshTang[p] *= firstWeight;
+                    meshBitang[p] *= firstWeight;
+                }
+                const float weight = CornerAngle(meshPos, face, b);
+                AccumulateTangent(meshTang[p], localTangent * weight);
+                AccumulateTangent(meshBitang[p], localBitangent * weight);
+                refs[p] = 2;
+                bSharedVertices = true;
+            }
+        }
+    }
+
+    // averaged tangents of shared vertices must be unit length again
+    if (bSharedVertices) {
+        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+            if (refs[i] > 1) {
+                meshTang[i].NormalizeSafe();
+                meshBitang[i].NormalizeSafe();
+            }
         }
     }
 
@@ -233,10 +297,26 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
             ;
         }
     }
+    if (!vertexFinder) {
+        posEpsilon = ComputePositionEpsilon(pMesh);
+    }
+
+    // in a welded mesh no two vertices are within posEpsilon of each other, so the index buffer
+    // already merged the tangents of the faces around each vertex and there is nothing left to
+    // smooth by position. Normalize them the same way the smoothing below does.
+    if (bSharedVertices && HasUniquePositions(pMesh, posEpsilon)) {
+        for (unsigned int a = 0; a < pMesh->mNumVertices; a++) {
+            if (!vertexDone[a]) {
+                meshTang[a].Normalize();
+                meshBitang[a].Normalize();
+            }
+        }
+        return true;
+    }
+
     if (!vertexFinder) {
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
         vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
     }
     std::vector<unsigned int> verticesFound;
 
@@ -149,15 +149,26 @@ void MakeLeftHandedProcess::ProcessMesh(aiMesh *pMesh) {
         ASSIMP_LOG_ERROR("Nullptr to mesh found.");
         return;
     }
-    // mirror positions, normals and stuff along the Z axis
+    // mirror positions, normals and stuff along the Z axis. Each channel is
+    // processed in its own loop so the checks are done once per mesh.
     for (size_t a = 0; a < pMesh->mNumVertices; ++a) {
         pMesh->mVertices[a].z *= -1.0f;
-        if (pMesh->HasNormals()) {
+    }
+    if (pMesh->HasNormals()) {
+        for (size_t a = 0; a < pMesh->mNumVertices; ++a) {
             pMesh->mNormals[a].z *= -1.0f;
         }
-        if (pMesh->HasTangentsAndBitangents()) {
+    }
+    if (pMesh->HasTangentsAndBitangents()) {
+        for (size_t a = 0; a < pMesh->mNumVertices; ++a) {
             pMesh->mTangents[a].z *= -1.0f;
-            pMesh->mBitangents[a].z *= -1.0f;
+        }
+
+        // bitangents are mirrored along the Z axis and as they're derived from
+        // the texture coords also negated, which leaves only Z untouched
+        for (size_t a = 0; a < pMesh->mNumVertices; ++a) {
+            pMesh->mBitangents[a].x *= -1.0f;
+            pMesh->mBitangents[a].y *= -1.0f;
         }
     }
 
@@ -185,12 +196,6 @@ void MakeLeftHandedProcess::ProcessMesh(aiMesh *pMesh) {
         bone->mOffsetMatrix.c2 = -bone->mOffsetMatrix.c2;
         bone->mOffsetMatrix.c4 = -bone->mOffsetMatrix.c4;
     }
-
-    // mirror bitangents as well as they're derived from the texture coords
-    if (pMesh->HasTangentsAndBitangents()) {
-        for (unsigned int a = 0; a < pMesh->mNumVertices; a++)
-            pMesh->mBitangents[a] *= -1.0f;
-    }
 }
 
 // ------------------------------------------------------------------------------------------------
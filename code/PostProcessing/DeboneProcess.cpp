@@ -46,9 +46,69 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "DeboneProcess.h"
 #include <stdio.h>
+#include <string>
+#include <unordered_map>
 
 using namespace Assimp;
 
+namespace {
+
+const unsigned int cUnowned = UINT_MAX;
+const unsigned int cCoowned = UINT_MAX-1;
+
+// ------------------------------------------------------------------------------------------------
+// Builds the per-vertex ownership table of a mesh in a single pass over the bone weights. A vertex
+// is owned by the only bone influencing it above the threshold, cCoowned if several bones do, and
+// cUnowned if none does. A bone is flagged as necessary as soon as it has a weight below the
+// threshold. Returns true if at least one bone is not necessary yet.
+bool BuildVertexOwners(const aiMesh *pMesh, float threshold, std::vector<unsigned int> &vertexBones,
+        std::vector<bool> &isBoneNecessary) {
+    vertexBones.assign(pMesh->mNumVertices, cUnowned);
+    isBoneNecessary.assign(pMesh->mNumBones, false);
+
+    bool anyRemovable = false;
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        const aiBone *bone = pMesh->mBones[i];
+        bool necessary = false;
+        for (unsigned int j = 0; j < bone->mNumWeights; ++j) {
+            const float w = bone->mWeights[j].mWeight;
+            if (w == 0.0f) {
+                continue;
+            }
+
+            if (w < threshold) {
+                necessary = true;
+                continue;
+            }
+
+            unsigned int &owner = vertexBones[bone->mWeights[j].mVertexId];
+            if (owner == cUnowned) {
+                owner = i;
+            } else if (owner == i) {
+                ASSIMP_LOG_WARN("Encountered double entry in bone weights");
+            } else {
+                //TODO: track attraction in order to break tie
+                owner = cCoowned;
+            }
+        }
+
+        isBoneNecessary[i] = necessary;
+        anyRemovable |= !necessary;
+    }
+    return anyRemovable;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collects all nodes by name, keeping the first one in depth-first order just like aiNode::FindNode.
+void CollectNodesByName(aiNode *pNode, std::unordered_map<std::string, aiNode*> &nodes) {
+    nodes.emplace(pNode->mName.C_Str(), pNode);
+    for (unsigned int a = 0; a < pNode->mNumChildren; ++a) {
+        CollectNodesByName(pNode->mChildren[a], nodes);
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 DeboneProcess::DeboneProcess() : mNumBones(0), mNumBonesCanDoWithout(0), mThreshold(AI_DEBONE_THRESHOLD), mAllOrNone(false) {}
@@ -99,6 +159,11 @@ void DeboneProcess::Execute( aiScene* pScene) {
         // build a new array of meshes for the scene
         std::vector<aiMesh*> meshes;
 
+        // resolve the bone nodes through a name lookup built once instead of searching the tree per submesh
+        std::unordered_map<std::string, aiNode*> nodesByName;
+        CollectNodesByName(pScene->mRootNode, nodesByName);
+        mNodeSubMeshes.clear();
+
         for (unsigned int a=0;a<pScene->mNumMeshes; ++a) {
             aiMesh* srcMesh = pScene->mMeshes[a];
             std::vector<std::pair<aiMesh*,const aiBone*> > newMeshes;
@@ -115,17 +180,24 @@ void DeboneProcess::Execute( aiScene* pScene) {
                 for(unsigned int b=0;b<newMeshes.size();b++)    {
                     const aiString *find = newMeshes[b].second ? &newMeshes[b].second->mName : nullptr;
 
-                    aiNode *theNode = find ? pScene->mRootNode->FindNode(*find) : nullptr;
+                    aiNode *theNode = nullptr;
+                    if (find) {
+                        auto it = nodesByName.find(find->C_Str());
+                        theNode = it != nodesByName.end() ? it->second : nullptr;
+                    }
                     std::pair<unsigned int,aiNode*> push_pair(static_cast<unsigned int>(meshes.size()),theNode);
 
                     mSubMeshIndices[a].emplace_back(push_pair);
+                    if (theNode) {
+                        mNodeSubMeshes[theNode].push_back(push_pair.first);
+                    }
                     meshes.emplace_back(newMeshes[b].first);
 
                     out+=newMeshes[b].first->mNumBones;
                 }
 
                 if(!DefaultLogger::isNullLogger()) {
-                    ASSIMP_LOG_INFO("Removed %u bones. Input bones:", in - out, ". Output bones: ", out);
+                    ASSIMP_LOG_INFO("Removed ", in - out, " bones. Input bones: ", in, ". Output bones: ", out);
                 }
 
                 // and destroy the source mesh. It should be completely contained inside the new submeshes
@@ -159,46 +231,11 @@ bool DeboneProcess::ConsiderMesh(const aiMesh* pMesh) {
 
     bool split = false;
 
-    //interstitial faces not permitted
-    bool isInterstitialRequired = false;
-
-    std::vector<bool> isBoneNecessary(pMesh->mNumBones,false);
-    std::vector<unsigned int> vertexBones(pMesh->mNumVertices,UINT_MAX);
-
-    const unsigned int cUnowned = UINT_MAX;
-    const unsigned int cCoowned = UINT_MAX-1;
-
-    for(unsigned int i=0;i<pMesh->mNumBones;i++)    {
-        for(unsigned int j=0;j<pMesh->mBones[i]->mNumWeights;j++)   {
-            float w = pMesh->mBones[i]->mWeights[j].mWeight;
-            if (w == 0.0f) {
-                continue;
-            }
-
-            unsigned int vid = pMesh->mBones[i]->mWeights[j].mVertexId;
-            if (w >= mThreshold)   {
-                if (vertexBones[vid] != cUnowned) {
-                    //double entry
-                    if(vertexBones[vid]==i)  {
-                        ASSIMP_LOG_WARN("Encountered double entry in bone weights");
-                    } else  {
-                        //TODO: track attraction in order to break tie
-                        vertexBones[vid] = cCoowned;
-                    }
-                } else {
-                    vertexBones[vid] = i;
-                } 
-            }
-
-            if(!isBoneNecessary[i]) {
-                isBoneNecessary[i] = w<mThreshold;
-            }
-        }
+    std::vector<bool> isBoneNecessary;
+    std::vector<unsigned int> vertexBones;
 
-        if(!isBoneNecessary[i])  {
-            isInterstitialRequired = true;
-        }
-    }
+    //interstitial faces not permitted
+    const bool isInterstitialRequired = BuildVertexOwners(pMesh, mThreshold, vertexBones, isBoneNecessary);
 
     if(isInterstitialRequired) {
         for(unsigned int i=0;i<pMesh->mNumFaces;i++) {
@@ -232,43 +269,10 @@ bool DeboneProcess::ConsiderMesh(const aiMesh* pMesh) {
 // ------------------------------------------------------------------------------------------------
 // Splits the given mesh by bone count.
 void DeboneProcess::SplitMesh( const aiMesh* pMesh, std::vector< std::pair< aiMesh*,const aiBone* > >& poNewMeshes) const {
-    // same deal here as ConsiderMesh basically
-
-    std::vector<bool> isBoneNecessary(pMesh->mNumBones,false);
-    std::vector<unsigned int> vertexBones(pMesh->mNumVertices,UINT_MAX);
-
-    const unsigned int cUnowned = UINT_MAX;
-    const unsigned int cCoowned = UINT_MAX-1;
-
-    for(unsigned int i=0;i<pMesh->mNumBones;i++)    {
-        for(unsigned int j=0;j<pMesh->mBones[i]->mNumWeights;j++)   {
-            float w = pMesh->mBones[i]->mWeights[j].mWeight;
-
-            if(w==0.0f) {
-                continue;
-            }
-
-            unsigned int vid = pMesh->mBones[i]->mWeights[j].mVertexId;
-
-            if(w>=mThreshold) {
-                if(vertexBones[vid]!=cUnowned)  {
-                    if(vertexBones[vid]==i) //double entry
-                    {
-                        ASSIMP_LOG_WARN("Encountered double entry in bone weights");
-                    }
-                    else //TODO: track attraction in order to break tie
-                    {
-                        vertexBones[vid] = cCoowned;
-                    }
-                }
-                else vertexBones[vid] = i;
-            }
-
-            if(!isBoneNecessary[i]) {
-                isBoneNecessary[i] = w<mThreshold;
-            }
-        }
-    }
+    // same ownership table as in ConsiderMesh
+    std::vector<bool> isBoneNecessary;
+    std::vector<unsigned int> vertexBones;
+    BuildVertexOwners(pMesh, mThreshold, vertexBones, isBoneNecessary);
 
     unsigned int nFacesUnowned = 0;
 
@@ -324,16 +328,24 @@ void DeboneProcess::SplitMesh( const aiMesh* pMesh, std::vector< std::pair< aiMe
         poNewMeshes.push_back(push_pair);
     }
 
+    // bucket the faces of all removable bones in one pass, keeping them in their original order
+    std::vector<unsigned int> boneFaceStart(pMesh->mNumBones+1,0);
     for(unsigned int i=0;i<pMesh->mNumBones;i++) {
+        boneFaceStart[i+1] = boneFaceStart[i] + facesPerBone[i];
+    }
 
-        if(!isBoneNecessary[i]&&facesPerBone[i]>0)  {
-            std::vector<unsigned int> subFaces;
+    std::vector<unsigned int> boneFaces(boneFaceStart.back());
+    std::vector<unsigned int> boneFaceCursor(boneFaceStart.begin(), boneFaceStart.end()-1);
+    for(unsigned int j=0;j<pMesh->mNumFaces;j++) {
+        if(faceBones[j]<pMesh->mNumBones) {
+            boneFaces[boneFaceCursor[faceBones[j]]++] = j;
+        }
+    }
 
-            for(unsigned int j=0;j<pMesh->mNumFaces;j++)    {
-                if(faceBones[j]==i) {
-                    subFaces.push_back(j);
-                }
-            }
+    for(unsigned int i=0;i<pMesh->mNumBones;i++) {
+
+        if(!isBoneNecessary[i]&&facesPerBone[i]>0)  {
+            std::vector<unsigned int> subFaces(boneFaces.begin()+boneFaceStart[i], boneFaces.begin()+boneFaceStart[i+1]);
 
             unsigned int f = AI_SUBMESH_FLAGS_SANS_BONES;
             aiMesh *subMesh =MakeSubmesh(pMesh,subFaces,f);
@@ -354,11 +366,9 @@ void DeboneProcess::UpdateNode(aiNode* pNode) const {
 
     std::vector<unsigned int> newMeshList;
 
-    // this will require two passes
-
-    unsigned int m = static_cast<unsigned int>(pNode->mNumMeshes), n = static_cast<unsigned int>(mSubMeshIndices.size());
+    unsigned int m = static_cast<unsigned int>(pNode->mNumMeshes);
 
-    // first pass, look for meshes which have not moved
+    // first, the meshes which have not moved
     for(unsigned int a=0;a<m;a++)   {
         unsigned int srcIndex = pNode->mMeshes[a];
         const std::vector< std::pair< unsigned int,aiNode* > > &subMeshes = mSubMeshIndices[srcIndex];
@@ -371,17 +381,10 @@ void DeboneProcess::UpdateNode(aiNode* pNode) const {
         }
     }
 
-    // second pass, collect deboned meshes
-
-    for(unsigned int a=0;a<n;a++) {
-        const std::vector< std::pair< unsigned int,aiNode* > > &subMeshes = mSubMeshIndices[a];
-        unsigned int nSubmeshes = static_cast<unsigned int>(subMeshes.size());
-
-        for(unsigned int b=0;b<nSubmeshes;b++) {
-            if(subMeshes[b].second == pNode)    {
-                newMeshList.push_back(subMeshes[b].first);
-            }
-        }
+    // then the deboned meshes attached to this node
+    auto it = mNodeSubMeshes.find(pNode);
+    if (it != mNodeSubMeshes.end()) {
+        newMeshList.insert(newMeshList.end(), it->second.begin(), it->second.end());
     }
 
     if( pNode->mNumMeshes > 0 ) {
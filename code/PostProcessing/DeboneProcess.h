@@ -49,8 +49,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
 
-#include <vector>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #// Forward declarations
 class DeboneTest;
@@ -67,7 +68,7 @@ namespace Assimp {
 * the bone are split from the mesh. The split off (new) mesh is boneless. At any
 * point in time, bones without affect upon a given mesh are to be removed.
 */
-class DeboneProcess : public BaseProcess {
+class ASSIMP_API DeboneProcess : public BaseProcess {
 public:
     DeboneProcess();
     ~DeboneProcess() override = default;
@@ -124,6 +125,9 @@ public:
 
     /// Per mesh index: Array of indices of the new submeshes.
     std::vector< std::vector< std::pair< unsigned int,aiNode* > > > mSubMeshIndices;
+
+    /// Per bone node: indices of the deboned submeshes to attach to it, in mesh order.
+    std::unordered_map< const aiNode*,std::vector< unsigned int > > mNodeSubMeshes;
 };
 
 } // end of namespace Assimp
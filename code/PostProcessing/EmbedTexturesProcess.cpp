@@ -43,9 +43,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
 #include <assimp/ParsingUtils.h>
+#include <assimp/Hash.h>
 #include "ProcessHelper.h"
 
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 using namespace Assimp;
 
@@ -59,11 +63,56 @@ void EmbedTexturesProcess::SetupProperties(const Importer* pImp) {
     mIOHandler = pImp->GetIOHandler();
 }
 
+// Canonicalize a path for comparisons: unify the separators and
+// remove empty, '.' and 'dir/..' segments.
+static std::string canonicalizePath(const std::string &path) {
+    std::vector<std::string> segments;
+    std::string segment;
+    const bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+    for (size_t i = 0; i <= path.size(); ++i) {
+        if (i < path.size() && path[i] != '/' && path[i] != '\\') {
+            segment += path[i];
+            continue;
+        }
+        if (segment == "..") {
+            if (!segments.empty() && segments.back() != "..") {
+                segments.pop_back();
+            } else if (!absolute) {
+                segments.push_back(segment);
+            }
+        } else if (!segment.empty() && segment != ".") {
+            segments.push_back(segment);
+        }
+        segment.clear();
+    }
+
+    std::string result = absolute ? "/" : "";
+    for (size_t i = 0; i < segments.size(); ++i) {
+        result += (i ? "/" : "") + segments[i];
+    }
+    return result;
+}
+
+// Check whether two compressed textures hold the same data
+static bool isSameTexture(const aiTexture *a, const aiTexture *b) {
+    return a->mWidth == b->mWidth && a->mHeight == b->mHeight &&
+           !::strncmp(a->achFormatHint, b->achFormatHint, HINTMAXTEXTURELEN) &&
+           !::memcmp(a->pcData, b->pcData, a->mWidth);
+}
+
 void EmbedTexturesProcess::Execute(aiScene* pScene) {
     if (pScene == nullptr || pScene->mRootNode == nullptr || mIOHandler == nullptr){
         return;
     }
 
+    // Textures are looked up by the path as written in the material first, then by the
+    // canonical resolved path and at last by content. Each file is read at most once and
+    // files with identical content are embedded once. -1 marks a file which can't be loaded.
+    std::map<std::string, int> texturesByPath;
+    std::map<std::string, int> texturesByResolvedPath;
+    std::unordered_multimap<uint32_t, unsigned int> texturesByHash;
+    std::vector<aiTexture*> newTextures;
+
     aiString path;
     uint32_t embeddedTexturesCount = 0u;
     for (auto matId = 0u; matId < pScene->mNumMaterials; ++matId) {
@@ -77,10 +126,41 @@ void EmbedTexturesProcess::Execute(aiScene* pScene) {
                 material->GetTexture(tt, texId, &path);
                 if (path.data[0] == '*') continue; // Already embedded
 
+                auto byPath = texturesByPath.find(path.data);
+                if (byPath == texturesByPath.end()) {
+                    int textureId = -1;
+                    const std::string imagePath = resolvePath(path.data);
+                    if (!imagePath.empty()) {
+                        auto byResolvedPath = texturesByResolvedPath.emplace(canonicalizePath(imagePath), -1);
+                        if (byResolvedPath.second) {
+                            aiTexture *texture = loadTexture(imagePath, path.data);
+                            if (texture != nullptr) {
+                                const uint32_t hash = SuperFastHash(reinterpret_cast<const char*>(texture->pcData), texture->mWidth);
+                                auto range = texturesByHash.equal_range(hash);
+                                for (auto it = range.first; it != range.second; ++it) {
+                                    if (isSameTexture(texture, newTextures[it->second])) {
+                                        textureId = static_cast<int>(pScene->mNumTextures + it->second);
+                                        break;
+                                    }
+                                }
+                                if (textureId < 0) {
+                                    texturesByHash.emplace(hash, static_cast<unsigned int>(newTextures.size()));
+                                    textureId = static_cast<int>(pScene->mNumTextures + newTextures.size());
+                                    newTextures.push_back(texture);
+                                } else {
+                                    delete texture;
+                                }
+                            }
+                            byResolvedPath.first->second = textureId;
+                        }
+                        textureId = byResolvedPath.first->second;
+                    }
+                    byPath = texturesByPath.emplace(path.data, textureId).first;
+                }
+
                 // Indeed embed
-                if (addTexture(pScene, path.data)) {
-                    auto embeddedTextureId = pScene->mNumTextures - 1u;
-                    path.length = ::ai_snprintf(path.data, 1024, "*%u", embeddedTextureId);
+                if (byPath->second >= 0) {
+                    path.length = ::ai_snprintf(path.data, 1024, "*%u", static_cast<unsigned int>(byPath->second));
                     material->AddProperty(&path, AI_MATKEY_TEXTURE(tt, texId));
                     embeddedTexturesCount++;
                 }
@@ -88,12 +168,23 @@ void EmbedTexturesProcess::Execute(aiScene* pScene) {
         }
     }
 
-    ASSIMP_LOG_INFO("EmbedTexturesProcess finished. Embedded ", embeddedTexturesCount, " textures." );
+    // Enlarging the textures table once for all new textures
+    if (!newTextures.empty()) {
+        auto oldTextures = pScene->mTextures;
+        pScene->mTextures = new aiTexture*[pScene->mNumTextures + newTextures.size()];
+        if (oldTextures != nullptr) {
+            ::memmove(pScene->mTextures, oldTextures, sizeof(aiTexture*) * pScene->mNumTextures);
+        }
+        ::memcpy(pScene->mTextures + pScene->mNumTextures, newTextures.data(), sizeof(aiTexture*) * newTextures.size());
+        pScene->mNumTextures += static_cast<unsigned int>(newTextures.size());
+        delete [] oldTextures;
+    }
+
+    ASSIMP_LOG_INFO("EmbedTexturesProcess finished. Embedded ", newTextures.size(), " textures for ", embeddedTexturesCount, " texture references." );
 }
 
-bool EmbedTexturesProcess::addTexture(aiScene *pScene, const std::string &path) const {
-    std::streampos imageSize = 0;
-    std::string    imagePath = path;
+std::string EmbedTexturesProcess::resolvePath(const std::string &path) const {
+    std::string imagePath = path;
 
     // Test path directly
     if (!mIOHandler->Exists(imagePath)) {
@@ -106,14 +197,19 @@ bool EmbedTexturesProcess::addTexture(aiScene *pScene, const std::string &path)
             imagePath = mRootPath + path.substr(path.find_last_of("\\/") + 1u);
             if (!mIOHandler->Exists(imagePath)) {
                 ASSIMP_LOG_ERROR("EmbedTexturesProcess: Unable to embed texture: ", path, ".");
-                return false;
+                return std::string();
             }
         }
     }
+    return imagePath;
+}
+
+aiTexture *EmbedTexturesProcess::loadTexture(const std::string &imagePath, const std::string &path) const {
+    std::streampos imageSize = 0;
     IOStream* pFile = mIOHandler->Open(imagePath);
     if (pFile == nullptr) {
         ASSIMP_LOG_ERROR("EmbedTexturesProcess: Unable to embed texture: ", path, ".");
-        return false;
+        return nullptr;
     }
     imageSize = pFile->FileSize();
 
@@ -122,14 +218,7 @@ bool EmbedTexturesProcess::addTexture(aiScene *pScene, const std::string &path)
     pFile->Read(reinterpret_cast<char*>(imageContent), static_cast<size_t>(imageSize), 1);
     mIOHandler->Close(pFile);
 
-    // Enlarging the textures table
-    unsigned int textureId = pScene->mNumTextures++;
-    auto oldTextures = pScene->mTextures;
-    pScene->mTextures = new aiTexture*[pScene->mNumTextures];
-    ::memmove(pScene->mTextures, oldTextures, sizeof(aiTexture*) * (pScene->mNumTextures - 1u));
-    delete [] oldTextures;
-
-    // Add the new texture
+    // Create the new texture
     auto pTexture = new aiTexture;
     pTexture->mHeight = 0; // Means that this is still compressed
     pTexture->mWidth = static_cast<uint32_t>(imageSize);
@@ -146,7 +235,6 @@ bool EmbedTexturesProcess::addTexture(aiScene *pScene, const std::string &path)
         len = HINTMAXTEXTURELEN - 1;
     }
     ::strncpy(pTexture->achFormatHint, extension.c_str(), len);
-    pScene->mTextures[textureId] = pTexture;
 
-    return true;
+    return pTexture;
 }
@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 struct aiNode;
+struct aiTexture;
 
 class IOSystem;
 
@@ -58,6 +59,8 @@ namespace Assimp {
  *  (due, for instance, to an absolute path generated on another system),
  *  it will check if a file with the same name exists at the root folder
  *  of the imported model. And if so, it uses that.
+ *  Each file is embedded once, even if it is referenced through different
+ *  paths or if several files have identical content.
  */
 class ASSIMP_API EmbedTexturesProcess : public BaseProcess {
 public:
@@ -77,8 +80,11 @@ public:
     virtual void Execute(aiScene* pScene) override;
 
 private:
-    // Resolve the path and add the file content to the scene as a texture.
-    bool addTexture(aiScene *pScene, const std::string &path) const;
+    // Resolve the path of a texture file, returns an empty string if it can't be found.
+    std::string resolvePath(const std::string &path) const;
+
+    // Load the file content as a compressed texture.
+    aiTexture *loadTexture(const std::string &imagePath, const std::string &path) const;
 
 private:
     std::string mRootPath;
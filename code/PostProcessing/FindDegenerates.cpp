@@ -182,19 +182,16 @@ bool FindDegeneratesProcess::ExecuteOnMesh(aiMesh *mesh) {
                 }
             }
 
-            if (mConfigCheckAreaOfTriangle) {
-                if (face.mNumIndices == 3) {
-                    ai_real area = GeometryUtils::calculateAreaOfTriangle(face, mesh);
-                    if (area < ai_epsilon) {
-                        if (mConfigRemoveDegenerates) {
-                            remove_me[a] = true;
-                            ++deg;
-                            goto evil_jump_outside;
-                        }
-
-                        // todo: check for index which is corrupt.
-                    }
-                }
+        }
+
+        // the area only matters if degenerated faces are removed, and it needs
+        // to be computed once per face after duplicate indices are gone
+        if (mConfigCheckAreaOfTriangle && mConfigRemoveDegenerates && face.mNumIndices == 3) {
+            ai_real area = GeometryUtils::calculateAreaOfTriangle(face, mesh);
+            if (area < ai_epsilon) {
+                remove_me[a] = true;
+                ++deg;
+                goto evil_jump_outside;
             }
         }
 
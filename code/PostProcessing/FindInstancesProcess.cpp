@@ -47,8 +47,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "FindInstancesProcess.h"
+#include <cmath>
 #include <memory>
 #include <stdio.h>
+#include <unordered_map>
+#include <vector>
 
 using namespace Assimp;
 
@@ -91,7 +94,7 @@ bool CompareBones(const aiMesh* orig, const aiMesh* inst)
         // compare weight per weight ---
         for (unsigned int n = 0; n < aha->mNumWeights;++n) {
             if  (aha->mWeights[n].mVertexId != oha->mWeights[n].mVertexId ||
-                (aha->mWeights[n].mWeight - oha->mWeights[n].mWeight) < 10e-3f) {
+                std::fabs(aha->mWeights[n].mWeight - oha->mWeights[n].mWeight) >= 10e-3f) {
                 return false;
             }
         }
@@ -122,130 +125,134 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         // in the pipeline, so we could, depending on the file format,
         // have several thousand small meshes. That's too much for a brute
         // everyone-against-everyone check involving up to 10 comparisons
-        // each.
-        std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
+        // each, so all meshes we keep are bucketed by their hash and only
+        // the members of the matching bucket are compared.
+        typedef std::unordered_map<uint64_t, std::vector<unsigned int> > BucketMap;
+        BucketMap buckets;
+        buckets.reserve(pScene->mNumMeshes);
         std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
 
         unsigned int numMeshesOut = 0;
         for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 
             aiMesh* inst = pScene->mMeshes[i];
-            hashes[i] = GetMeshHash(inst);
-
-            // Find an appropriate epsilon
-            // to compare position differences against
-            float epsilon = ComputePositionEpsilon(inst);
-            epsilon *= epsilon;
+            std::vector<unsigned int>& bucket = buckets[GetMeshHash(inst)];
+
+            // Find an appropriate epsilon to compare position differences
+            // against - but only if there is anything to compare with.
+            float epsilon = 0.f;
+            if (!bucket.empty()) {
+                epsilon = ComputePositionEpsilon(inst);
+                epsilon *= epsilon;
+            }
 
-            for (int a = i-1; a >= 0; --a) {
-                if (hashes[i] == hashes[a])
-                {
-                    aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
+            // walk the bucket backwards, so the most recent match wins
+            for (std::vector<unsigned int>::const_reverse_iterator it = bucket.rbegin(); it != bucket.rend(); ++it) {
+                const unsigned int a = *it;
+                aiMesh* orig = pScene->mMeshes[a];
+
+                // check for hash collision .. we needn't check
+                // the vertex format, it *must* match due to the
+                // (brilliant) construction of the hash
+                if (orig->mNumBones       != inst->mNumBones      ||
+                    orig->mNumFaces       != inst->mNumFaces      ||
+                    orig->mNumVertices    != inst->mNumVertices   ||
+                    orig->mMaterialIndex  != inst->mMaterialIndex ||
+                    orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+                    continue;
+
+                // up to now the meshes are equal. Now compare vertex positions, normals,
+                // tangents and bitangents using this epsilon.
+                if (orig->HasPositions()) {
+                    if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
                         continue;
-
-                    // check for hash collision .. we needn't check
-                    // the vertex format, it *must* match due to the
-                    // (brilliant) construction of the hash
-                    if (orig->mNumBones       != inst->mNumBones      ||
-                        orig->mNumFaces       != inst->mNumFaces      ||
-                        orig->mNumVertices    != inst->mNumVertices   ||
-                        orig->mMaterialIndex  != inst->mMaterialIndex ||
-                        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+                }
+                if (orig->HasNormals()) {
+                    if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+                        continue;
+                }
+                if (orig->HasTangentsAndBitangents()) {
+                    if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+                        !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
                         continue;
+                }
 
-                    // up to now the meshes are equal. Now compare vertex positions, normals,
-                    // tangents and bitangents using this epsilon.
-                    if (orig->HasPositions()) {
-                        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
+                // use a constant epsilon for colors and UV coordinates
+                static const float uvEpsilon = 10e-4f;
+                {
+                    unsigned int j, end = orig->GetNumUVChannels();
+                    for(j = 0; j < end; ++j) {
+                        if (!orig->mTextureCoords[j]) {
                             continue;
+                        }
+                        if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
+                            break;
+                        }
                     }
-                    if (orig->HasNormals()) {
-                        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-                            continue;
+                    if (j != end) {
+                        continue;
                     }
-                    if (orig->HasTangentsAndBitangents()) {
-                        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-                            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+                }
+                {
+                    unsigned int j, end = orig->GetNumColorChannels();
+                    for(j = 0; j < end; ++j) {
+                        if (!orig->mColors[j]) {
                             continue;
-                    }
-
-                    // use a constant epsilon for colors and UV coordinates
-                    static const float uvEpsilon = 10e-4f;
-                    {
-                        unsigned int j, end = orig->GetNumUVChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mTextureCoords[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
                         }
-                        if (j != end) {
-                            continue;
+                        if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
+                            break;
                         }
                     }
-                    {
-                        unsigned int j, end = orig->GetNumColorChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mColors[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
-                        }
+                    if (j != end) {
+                        continue;
                     }
+                }
 
-                    // These two checks are actually quite expensive and almost *never* required.
-                    // Almost. That's why they're still here. But there's no reason to do them
-                    // in speed-targeted imports.
-                    if (!configSpeedFlag) {
-
-                        // It seems to be strange, but we really need to check whether the
-                        // bones are identical too. Although it's extremely unprobable
-                        // that they're not if control reaches here, we need to deal
-                        // with unprobable cases, too. It could still be that there are
-                        // equal shapes which are deformed differently.
-                        if (!CompareBones(orig,inst))
-                            continue;
+                // These two checks are actually quite expensive and almost *never* required.
+                // Almost. That's why they're still here. But there's no reason to do them
+                // in speed-targeted imports.
+                if (!configSpeedFlag) {
+
+                    // It seems to be strange, but we really need to check whether the
+                    // bones are identical too. Although it's extremely unprobable
+                    // that they're not if control reaches here, we need to deal
+                    // with unprobable cases, too. It could still be that there are
+                    // equal shapes which are deformed differently.
+                    if (!CompareBones(orig,inst))
+                        continue;
 
-                        // For completeness ... compare even the index buffers for equality
-                        // face order & winding order doesn't care. Input data is in verbose format.
-                        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
-                        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
+                    // For completeness ... compare even the index buffers for equality
+                    // face order & winding order doesn't care. Input data is in verbose format.
+                    std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
+                    std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
 
-                        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-                            aiFace& f = orig->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-                                ftbl_orig[f.mIndices[nn]] = tt;
+                    for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+                        aiFace& f = orig->mFaces[tt];
+                        for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+                            ftbl_orig[f.mIndices[nn]] = tt;
 
-                            aiFace& f2 = inst->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-                                ftbl_inst[f2.mIndices[nn]] = tt;
-                        }
-                        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-                            continue;
+                        aiFace& f2 = inst->mFaces[tt];
+                        for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+                            ftbl_inst[f2.mIndices[nn]] = tt;
                     }
+                    if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+                        continue;
+                }
 
-                    // We're still here. Or in other words: 'inst' is an instance of 'orig'.
-                    // Place a marker in our list that we can easily update mesh indices.
-                    remapping[i] = remapping[a];
+                // We're still here. Or in other words: 'inst' is an instance of 'orig'.
+                // Place a marker in our list that we can easily update mesh indices.
+                remapping[i] = remapping[a];
 
-                    // Delete the instanced mesh, we don't need it anymore
-                    delete inst;
-                    pScene->mMeshes[i] = nullptr;
-                    break;
-                }
+                // Delete the instanced mesh, we don't need it anymore
+                delete inst;
+                pScene->mMeshes[i] = nullptr;
+                break;
             }
 
             // If we didn't find a match for the current mesh: keep it
             if (pScene->mMeshes[i]) {
                 remapping[i] = numMeshesOut++;
+                bucket.push_back(i);
             }
         }
         ai_assert(0 != numMeshesOut);
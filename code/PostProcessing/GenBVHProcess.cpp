@@ -0,0 +1,375 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post processing step to build BVHs.
+ * <br>
+ * Nodes are split with a binned surface area heuristic: the centers of the
+ * primitive bounds are sorted into a fixed number of bins along each axis and
+ * the cheapest boundary between two bins is chosen. The nodes are emitted in
+ * depth-first order, so the first child always follows its parent and only
+ * the index of the second child has to be stored.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+
+#include "PostProcessing/GenBVHProcess.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Assimp {
+
+namespace {
+
+// Number of bins per axis used to evaluate the split candidates
+constexpr unsigned int NumBins = 16;
+
+// ------------------------------------------------------------------------------------------------
+aiAABB emptyBox() {
+    const ai_real max = std::numeric_limits<ai_real>::max();
+    return aiAABB(aiVector3D(max, max, max), aiVector3D(-max, -max, -max));
+}
+
+// ------------------------------------------------------------------------------------------------
+void grow(aiAABB &box, const aiVector3D &p) {
+    box.mMin = aiVector3D(std::min(box.mMin.x, p.x), std::min(box.mMin.y, p.y), std::min(box.mMin.z, p.z));
+    box.mMax = aiVector3D(std::max(box.mMax.x, p.x), std::max(box.mMax.y, p.y), std::max(box.mMax.z, p.z));
+}
+
+// ------------------------------------------------------------------------------------------------
+void grow(aiAABB &box, const aiAABB &other) {
+    grow(box, other.mMin);
+    grow(box, other.mMax);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Half the surface area of a non-empty box, which is all the heuristic needs
+ai_real halfArea(const aiAABB &box) {
+    const aiVector3D d = box.mMax - box.mMin;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiAABB transformBox(const aiAABB &box, const aiMatrix4x4 &m) {
+    aiAABB out = emptyBox();
+    for (unsigned int i = 0; i < 8; ++i) {
+        const aiVector3D corner((i & 1) ? box.mMax.x : box.mMin.x,
+                (i & 2) ? box.mMax.y : box.mMin.y,
+                (i & 4) ? box.mMax.z : box.mMin.z);
+        grow(out, m * corner);
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Appends the world-space bounds of all mesh instances in depth-first order
+void collectInstances(const aiNode *node, const aiMatrix4x4 &parent,
+        const std::vector<aiAABB> &meshBoxes, std::vector<aiAABB> &boxes) {
+    const aiMatrix4x4 world = parent * node->mTransformation;
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        boxes.push_back(transformBox(meshBoxes[node->mMeshes[i]], world));
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        collectInstances(node->mChildren[i], world, meshBoxes, boxes);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+class BVHBuilder {
+public:
+    BVHBuilder(const std::vector<aiAABB> &boxes, unsigned int maxLeafSize) :
+            mBoxes(boxes),
+            mMaxLeafSize(std::max(1u, maxLeafSize)),
+            mPrimitives(boxes.size()),
+            mCenters(boxes.size()) {
+        std::iota(mPrimitives.begin(), mPrimitives.end(), 0u);
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            mCenters[i] = (boxes[i].mMin + boxes[i].mMax) * static_cast<ai_real>(0.5);
+        }
+    }
+
+    aiBVH *build() {
+        struct Task {
+            unsigned int first, count, parent;
+        };
+        const unsigned int none = std::numeric_limits<unsigned int>::max();
+
+        // a binary tree with n leaves has 2n-1 nodes, estimated with full leaves
+        std::vector<aiBVHNode> nodes;
+        nodes.reserve(2 * mPrimitives.size() / mMaxLeafSize + 1);
+        std::vector<Task> stack;
+        stack.push_back({ 0, static_cast<unsigned int>(mPrimitives.size()), none });
+        while (!stack.empty()) {
+            const Task task = stack.back();
+            stack.pop_back();
+
+            const unsigned int index = static_cast<unsigned int>(nodes.size());
+            if (task.parent != none) {
+                nodes[task.parent].mOffset = index;
+            }
+            nodes.emplace_back();
+
+            aiAABB bounds = emptyBox(), centers = emptyBox();
+            for (unsigned int i = task.first; i < task.first + task.count; ++i) {
+                grow(bounds, mBoxes[mPrimitives[i]]);
+                grow(centers, mCenters[mPrimitives[i]]);
+            }
+            nodes[index].mAABB = bounds;
+
+            const unsigned int split = findSplit(task.first, task.count, bounds, centers);
+            if (0 == split) {
+                nodes[index].mOffset = task.first;
+                nodes[index].mNumPrimitives = task.count;
+                continue;
+            }
+
+            // the first child is processed next, so it directly follows its parent
+            stack.push_back({ task.first + split, task.count - split, index });
+            stack.push_back({ task.first, split, none });
+        }
+
+        aiBVH *bvh = new aiBVH();
+        bvh->mNumNodes = static_cast<unsigned int>(nodes.size());
+        bvh->mNodes = new aiBVHNode[bvh->mNumNodes];
+        std::copy(nodes.begin(), nodes.end(), bvh->mNodes);
+        bvh->mNumPrimitives = static_cast<unsigned int>(mPrimitives.size());
+        bvh->mPrimitives = new unsigned int[bvh->mNumPrimitives];
+        std::copy(mPrimitives.begin(), mPrimitives.end(), bvh->mPrimitives);
+        return bvh;
+    }
+
+private:
+    unsigned int binOf(unsigned int primitive, unsigned int axis, ai_real min, ai_real scale) const {
+        const ai_real pos = (mCenters[primitive][axis] - min) * scale;
+        return std::min(NumBins - 1, static_cast<unsigned int>(std::max(pos, static_cast<ai_real>(0))));
+    }
+
+    // Returns the number of primitives of the first child, 0 to make a leaf
+    unsigned int findSplit(unsigned int first, unsigned int count, const aiAABB &bounds, const aiAABB &centers) {
+        if (count < 2) {
+            return 0;
+        }
+
+        ai_real bestCost = std::numeric_limits<ai_real>::max(), bestMin = 0, bestScale = 0;
+        unsigned int bestAxis = 3, bestBin = 0;
+        for (unsigned int axis = 0; axis < 3; ++axis) {
+            const ai_real extent = centers.mMax[axis] - centers.mMin[axis];
+            if (extent <= 0) {
+                continue;
+            }
+            const ai_real scale = NumBins / extent;
+
+            aiAABB binBoxes[NumBins];
+            unsigned int binCounts[NumBins] = {};
+            std::fill(binBoxes, binBoxes + NumBins, emptyBox());
+            for (unsigned int i = first; i < first + count; ++i) {
+                const unsigned int bin = binOf(mPrimitives[i], axis, centers.mMin[axis], scale);
+                ++binCounts[bin];
+                grow(binBoxes[bin], mBoxes[mPrimitives[i]]);
+            }
+
+            // sweep from the right to get the cost of the second child for each boundary
+            ai_real rightCost[NumBins - 1];
+            aiAABB box = emptyBox();
+            unsigned int num = 0;
+            for (unsigned int bin = NumBins - 1; bin > 0; --bin) {
+                if (binCounts[bin]) {
+                    grow(box, binBoxes[bin]);
+                    num += binCounts[bin];
+                }
+                rightCost[bin - 1] = num ? num * halfArea(box) : 0;
+            }
+
+            box = emptyBox();
+            num = 0;
+            for (unsigned int bin = 0; bin < NumBins - 1; ++bin) {
+                if (binCounts[bin]) {
+                    grow(box, binBoxes[bin]);
+                    num += binCounts[bin];
+                }
+                if (0 == num || num == count) {
+                    continue;
+                }
+                const ai_real cost = num * halfArea(box) + rightCost[bin];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = bin;
+                    bestMin = centers.mMin[axis];
+                    bestScale = scale;
+                }
+            }
+        }
+
+        if (bestAxis == 3) {
+            // all centers coincide, only the leaf size limit forces a split
+            return count > mMaxLeafSize ? count / 2 : 0;
+        }
+
+        // traversing an inner node costs about as much as testing a primitive
+        const ai_real area = halfArea(bounds);
+        if (count <= mMaxLeafSize && area + bestCost >= count * area) {
+            return 0;
+        }
+
+        const auto begin = mPrimitives.begin() + first;
+        const auto mid = std::partition(begin, begin + count, [&](unsigned int primitive) {
+            return binOf(primitive, bestAxis, bestMin, bestScale) <= bestBin;
+        });
+        return static_cast<unsigned int>(mid - begin);
+    }
+
+    const std::vector<aiAABB> &mBoxes;
+    const unsigned int mMaxLeafSize;
+    std::vector<unsigned int> mPrimitives;
+    std::vector<aiVector3D> mCenters;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+GenBVHProcess::GenBVHProcess() :
+        mConfigScene(false),
+        mConfigMeshes(false),
+        mConfigMaxLeafSize(4) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenBVHProcess::IsActive(unsigned int) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenBVHProcess::SetupProperties(const Importer *pImp) {
+    mConfigScene = pImp->GetPropertyBool(AI_CONFIG_PP_GBVH_SCENE, false);
+    mConfigMeshes = pImp->GetPropertyBool(AI_CONFIG_PP_GBVH_MESHES, false);
+    mConfigMaxLeafSize = pImp->GetPropertyInteger(AI_CONFIG_PP_GBVH_MAX_LEAF_SIZE, 4);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenBVHProcess::Execute(aiScene *pScene) {
+    if (!mConfigScene && !mConfigMeshes) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenBVHProcess begin");
+
+    unsigned int numNodes = 0;
+    if (mConfigMeshes) {
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            aiMesh *mesh = pScene->mMeshes[i];
+            delete mesh->mBVH;
+            mesh->mBVH = BuildMeshBVH(mesh);
+            if (mesh->mBVH) {
+                numNodes += mesh->mBVH->mNumNodes;
+            }
+        }
+    }
+    if (mConfigScene) {
+        delete pScene->mBVH;
+        pScene->mBVH = BuildSceneBVH(pScene);
+        if (pScene->mBVH) {
+            ASSIMP_LOG_INFO("GenBVHProcess: ", pScene->mBVH->mNumPrimitives, " mesh instances in ",
+                    pScene->mBVH->mNumNodes, " scene BVH nodes");
+        }
+    }
+    if (numNodes) {
+        ASSIMP_LOG_INFO("GenBVHProcess: ", numNodes, " mesh BVH nodes generated");
+    }
+    ASSIMP_LOG_DEBUG("GenBVHProcess finished");
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBVH *GenBVHProcess::BuildBVH(const std::vector<aiAABB> &boxes) const {
+    if (boxes.empty()) {
+        return nullptr;
+    }
+    return BVHBuilder(boxes, mConfigMaxLeafSize).build();
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBVH *GenBVHProcess::BuildMeshBVH(const aiMesh *pMesh) const {
+    if (nullptr == pMesh->mVertices || 0 == pMesh->mNumFaces) {
+        return nullptr;
+    }
+
+    std::vector<aiAABB> boxes(pMesh->mNumFaces, emptyBox());
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace &face = pMesh->mFaces[i];
+        for (unsigned int j = 0; j < face.mNumIndices; ++j) {
+            grow(boxes[i], pMesh->mVertices[face.mIndices[j]]);
+        }
+    }
+    return BuildBVH(boxes);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiBVH *GenBVHProcess::BuildSceneBVH(const aiScene *pScene) const {
+    if (nullptr == pScene->mRootNode) {
+        return nullptr;
+    }
+
+    // meshes without vertices are treated as points at their node's origin
+    std::vector<aiAABB> meshBoxes(pScene->mNumMeshes);
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        const aiMesh *mesh = pScene->mMeshes[i];
+        if (mesh->mVertices && mesh->mNumVertices) {
+            meshBoxes[i] = emptyBox();
+            for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+                grow(meshBoxes[i], mesh->mVertices[v]);
+            }
+        }
+    }
+
+    std::vector<aiAABB> boxes;
+    collectInstances(pScene->mRootNode, aiMatrix4x4(), meshBoxes, boxes);
+    return BuildBVH(boxes);
+}
+
+} // namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_GENBVH_PROCESS
@@ -0,0 +1,132 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to build bounding volume hierarchies
+ *        over the mesh instances of the scene and over the faces of each mesh.
+ */
+#pragma once
+#ifndef AI_GENBVHPROCESS_H_INC
+#define AI_GENBVHPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/aabb.h>
+
+#include <vector>
+
+struct aiBVH;
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenBVHProcess builds bounding volume hierarchies using a binned
+ *  surface area heuristic. aiScene::mBVH covers the world-space bounds of
+ *  all mesh instances of the node graph, aiMesh::mBVH the faces of a mesh.
+ *
+ *  There is no aiPostProcessSteps flag left for this step, it is enabled by
+ *  setting #AI_CONFIG_PP_GBVH_SCENE or #AI_CONFIG_PP_GBVH_MESHES instead.
+ */
+class ASSIMP_API GenBVHProcess : public BaseProcess {
+public:
+    // -------------------------------------------------------------------
+    /// The default class constructor / destructor.
+    GenBVHProcess();
+    ~GenBVHProcess() override = default;
+
+    // -------------------------------------------------------------------
+    /// @brief Always returns false, the step is driven by the
+    ///        AI_CONFIG_PP_GBVH_XXX properties rather than by a flag.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    /// @brief The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    // -------------------------------------------------------------------
+    /// @brief Reads the AI_CONFIG_PP_GBVH_XXX properties.
+    void SetupProperties(const Importer* pImp) override;
+
+    // -------------------------------------------------------------------
+    /** @brief Builds a BVH over a set of bounding boxes.
+     *  @param boxes The bounds of the primitives, their indices are
+     *    stored in aiBVH::mPrimitives.
+     *  @return The new BVH, nullptr if there are no primitives.
+     */
+    aiBVH* BuildBVH(const std::vector<aiAABB>& boxes) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Builds the BVH over the faces of a mesh.
+     *  @return The new BVH, nullptr if the mesh has no faces.
+     */
+    aiBVH* BuildMeshBVH(const aiMesh* pMesh) const;
+
+    // -------------------------------------------------------------------
+    /** @brief Builds the BVH over the mesh instances of a scene.
+     *  @return The new BVH, nullptr if no node references a mesh.
+     */
+    aiBVH* BuildSceneBVH(const aiScene* pScene) const;
+
+    // -------------------------------------------------------------------
+    /// Setters for the configuration, mainly for the unit tests.
+    void SetBuildScene(bool build) { mConfigScene = build; }
+    void SetBuildMeshes(bool build) { mConfigMeshes = build; }
+    void SetMaxLeafSize(unsigned int size) { mConfigMaxLeafSize = size; }
+
+private:
+    //! Configuration parameter: build aiScene::mBVH.
+    bool mConfigScene;
+
+    //! Configuration parameter: build aiMesh::mBVH.
+    bool mConfigMeshes;
+
+    //! Configuration parameter: primitives per leaf.
+    unsigned int mConfigMaxLeafSize;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENBVH_PROCESS
+
+#endif // AI_GENBVHPROCESS_H_INC
@@ -0,0 +1,699 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post processing step to generate levels of detail.
+ * <br>
+ * The simplification is a greedy sequence of half-edge collapses ordered by
+ * the quadric error metric of Garland and Heckbert, "Surface Simplification
+ * Using Quadric Error Metrics". Collapsing a vertex into one of its neighbours
+ * keeps all vertex components intact, so each level only refers to a subset of
+ * the source vertices.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#include "PostProcessing/GenLODsProcess.h"
+
+#include <assimp/commonMetaData.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <queue>
+#include <string>
+#include <unordered_map>
+
+namespace Assimp {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Symmetric 4x4 error quadric, only the upper triangle is stored.
+struct Quadric {
+    double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+
+    Quadric() :
+            a00(0.0), a01(0.0), a02(0.0), a03(0.0), a11(0.0), a12(0.0), a13(0.0), a22(0.0), a23(0.0), a33(0.0) {
+        // empty
+    }
+
+    // Squared distance to the plane ax+by+cz+d=0, scaled by w
+    Quadric(double a, double b, double c, double d, double w) :
+            a00(w * a * a), a01(w * a * b), a02(w * a * c), a03(w * a * d),
+            a11(w * b * b), a12(w * b * c), a13(w * b * d),
+            a22(w * c * c), a23(w * c * d),
+            a33(w * d * d) {
+        // empty
+    }
+
+    Quadric &operator+=(const Quadric &o) {
+        a00 += o.a00; a01 += o.a01; a02 += o.a02; a03 += o.a03;
+        a11 += o.a11; a12 += o.a12; a13 += o.a13;
+        a22 += o.a22; a23 += o.a23;
+        a33 += o.a33;
+        return *this;
+    }
+
+    double Evaluate(const aiVector3D &p) const {
+        const double x = p.x, y = p.y, z = p.z;
+        return a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+               a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+               a22 * z * z + 2.0 * a23 * z +
+               a33;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// Hash for bitwise identical positions
+struct PositionHash {
+    size_t operator()(const aiVector3D &v) const {
+        std::hash<ai_real> h;
+        size_t seed = h(v.x);
+        seed ^= h(v.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= h(v.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+// A queued half-edge collapse, mFrom is moved onto mTo
+struct Collapse {
+    double mCost;
+    unsigned int mFrom, mTo, mStamp;
+
+    bool operator<(const Collapse &o) const {
+        // std::priority_queue pops the largest element first
+        return mCost > o.mCost;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+class MeshSimplifier {
+public:
+    explicit MeshSimplifier(const aiMesh *pMesh);
+
+    // Collapses edges until at most targetFaces are left. Returns false if
+    // the error bound or the topology stopped the simplification early.
+    bool Simplify(unsigned int targetFaces, double maxError);
+
+    unsigned int GetNumFaces() const { return mNumFaces; }
+
+    // Appends the current index buffer to out
+    void GetIndices(std::vector<unsigned int> &out) const;
+
+private:
+    bool IsValid(unsigned int from, unsigned int to) const;
+    double Cost(unsigned int from, unsigned int to) const;
+    void GetNeighbours(unsigned int v, std::vector<unsigned int> &out) const;
+    void PushBestCollapse(unsigned int v);
+    void DoCollapse(unsigned int from, unsigned int to);
+
+    const aiMesh *mMesh;
+    std::vector<unsigned int> mIndices;
+    std::vector<bool> mFaceAlive;
+    std::vector<std::vector<unsigned int> > mVertexFaces;
+    std::vector<Quadric> mQuadrics;
+    std::vector<double> mWeights;
+    std::vector<bool> mLocked;
+    std::vector<bool> mVertexAlive;
+    std::vector<unsigned int> mStamps;
+    std::priority_queue<Collapse> mQueue;
+    unsigned int mNumFaces;
+};
+
+// ------------------------------------------------------------------------------------------------
+MeshSimplifier::MeshSimplifier(const aiMesh *pMesh) :
+        mMesh(pMesh),
+        mIndices(pMesh->mNumFaces * 3),
+        mFaceAlive(pMesh->mNumFaces, true),
+        mVertexFaces(pMesh->mNumVertices),
+        mQuadrics(pMesh->mNumVertices),
+        mWeights(pMesh->mNumVertices, 0.0),
+        mLocked(pMesh->mNumVertices, false),
+        mVertexAlive(pMesh->mNumVertices, true),
+        mStamps(pMesh->mNumVertices, 0),
+        mNumFaces(0) {
+    const unsigned int numVertices = pMesh->mNumVertices;
+
+    // Vertices sharing a position with others sit on an attribute seam. Collapsing
+    // them would tear the seam apart, so they are locked along with all vertices
+    // on borders or non-manifold edges.
+    std::unordered_map<aiVector3D, unsigned int, PositionHash> positions;
+    positions.reserve(numVertices);
+    std::vector<unsigned int> weld(numVertices);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        auto it = positions.emplace(pMesh->mVertices[i], i);
+        weld[i] = it.first->second;
+        if (!it.second) {
+            mLocked[i] = mLocked[weld[i]] = true;
+        }
+    }
+
+    std::unordered_map<uint64_t, unsigned int> edges;
+    edges.reserve(pMesh->mNumFaces * 3);
+    for (unsigned int f = 0; f < pMesh->mNumFaces; ++f) {
+        const aiFace &face = pMesh->mFaces[f];
+        unsigned int *tri = &mIndices[f * 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            tri[i] = face.mIndices[i];
+        }
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0]) {
+            mFaceAlive[f] = false;
+            continue;
+        }
+        ++mNumFaces;
+
+        const aiVector3D &p0 = pMesh->mVertices[tri[0]];
+        const aiVector3D n = (pMesh->mVertices[tri[1]] - p0) ^ (pMesh->mVertices[tri[2]] - p0);
+        const double len = n.Length();
+        for (unsigned int i = 0; i < 3; ++i) {
+            mVertexFaces[tri[i]].push_back(f);
+
+            const uint64_t a = weld[tri[i]], b = weld[tri[(i + 1) % 3]];
+            ++edges[a < b ? (a << 32 | b) : (b << 32 | a)];
+        }
+        if (len <= 0.0) {
+            continue;
+        }
+
+        // Area weighted plane quadric, the weights are summed separately to
+        // turn the error into a mean squared distance
+        const double a = n.x / len, b = n.y / len, c = n.z / len;
+        const Quadric q(a, b, c, -(a * p0.x + b * p0.y + c * p0.z), len * 0.5);
+        for (unsigned int i = 0; i < 3; ++i) {
+            mQuadrics[tri[i]] += q;
+            mWeights[tri[i]] += len * 0.5;
+        }
+    }
+
+    std::vector<bool> lockedPositions(numVertices, false);
+    for (const auto &edge : edges) {
+        if (edge.second != 2) {
+            lockedPositions[edge.first >> 32] = lockedPositions[edge.first & 0xffffffff] = true;
+        }
+    }
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        if (lockedPositions[weld[i]]) {
+            mLocked[i] = true;
+        }
+    }
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        PushBestCollapse(i);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::GetNeighbours(unsigned int v, std::vector<unsigned int> &out) const {
+    out.clear();
+    for (unsigned int f : mVertexFaces[v]) {
+        if (!mFaceAlive[f]) {
+            continue;
+        }
+        for (unsigned int i = 0; i < 3; ++i) {
+            if (mIndices[f * 3 + i] != v) {
+                out.push_back(mIndices[f * 3 + i]);
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+// Mean squared distance of the target to the planes around both vertices, plus a
+// penalty for the deviation of the normals which keeps creases and curved areas
+double MeshSimplifier::Cost(unsigned int from, unsigned int to) const {
+    const aiVector3D &target = mMesh->mVertices[to];
+    Quadric q = mQuadrics[from];
+    q += mQuadrics[to];
+    const double weight = mWeights[from] + mWeights[to];
+    double cost = weight > 0.0 ? std::max(q.Evaluate(target) / weight, 0.0) : 0.0;
+
+    if (mMesh->HasNormals()) {
+        const double cosine = mMesh->mNormals[from] * mMesh->mNormals[to];
+        if (cosine < 1.0) {
+            cost += 0.1 * (target - mMesh->mVertices[from]).SquareLength() * (1.0 - cosine);
+        }
+    }
+    return cost;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::IsValid(unsigned int from, unsigned int to) const {
+    // The edge must be shared by exactly two faces, otherwise the collapse
+    // would produce non-manifold geometry
+    std::vector<unsigned int> nFrom, nTo;
+    GetNeighbours(from, nFrom);
+    GetNeighbours(to, nTo);
+    std::vector<unsigned int> common;
+    std::set_intersection(nFrom.begin(), nFrom.end(), nTo.begin(), nTo.end(), std::back_inserter(common));
+    if (common.size() != 2) {
+        return false;
+    }
+
+    // None of the remaining faces around 'from' may flip or degenerate
+    const aiVector3D &target = mMesh->mVertices[to];
+    for (unsigned int f : mVertexFaces[from]) {
+        if (!mFaceAlive[f]) {
+            continue;
+        }
+        const unsigned int *tri = &mIndices[f * 3];
+        if (tri[0] == to || tri[1] == to || tri[2] == to) {
+            continue;
+        }
+        const unsigned int i = tri[0] == from ? 0 : (tri[1] == from ? 1 : 2);
+        const aiVector3D &p1 = mMesh->mVertices[tri[(i + 1) % 3]];
+        const aiVector3D &p2 = mMesh->mVertices[tri[(i + 2) % 3]];
+        const aiVector3D before = (p1 - mMesh->mVertices[from]) ^ (p2 - mMesh->mVertices[from]);
+        const aiVector3D after = (p1 - target) ^ (p2 - target);
+        const double dot = before * after;
+        if (dot <= 0.0 || dot * dot < 0.04 * before.SquareLength() * after.SquareLength()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::PushBestCollapse(unsigned int v) {
+    if (mLocked[v] || !mVertexAlive[v]) {
+        return;
+    }
+    std::vector<unsigned int> neighbours;
+    GetNeighbours(v, neighbours);
+
+    Collapse best = { 0.0, v, UINT_MAX, ++mStamps[v] };
+    for (unsigned int n : neighbours) {
+        const double cost = Cost(v, n);
+        if ((best.mTo == UINT_MAX || cost < best.mCost) && IsValid(v, n)) {
+            best.mCost = cost;
+            best.mTo = n;
+        }
+    }
+    if (best.mTo != UINT_MAX) {
+        mQueue.push(best);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::DoCollapse(unsigned int from, unsigned int to) {
+    for (unsigned int f : mVertexFaces[from]) {
+        if (!mFaceAlive[f]) {
+            continue;
+        }
+        unsigned int *tri = &mIndices[f * 3];
+        if (tri[0] == to || tri[1] == to || tri[2] == to) {
+            mFaceAlive[f] = false;
+            --mNumFaces;
+            continue;
+        }
+        *std::find(tri, tri + 3, from) = to;
+        mVertexFaces[to].push_back(f);
+    }
+    mVertexFaces[from].clear();
+    mVertexAlive[from] = false;
+    mQuadrics[to] += mQuadrics[from];
+    mWeights[to] += mWeights[from];
+
+    std::vector<unsigned int> &faces = mVertexFaces[to];
+    faces.erase(std::remove_if(faces.begin(), faces.end(), [this](unsigned int f) { return !mFaceAlive[f]; }), faces.end());
+
+    // Re-evaluate all vertices whose neighbourhood has changed
+    std::vector<unsigned int> neighbours;
+    GetNeighbours(to, neighbours);
+    PushBestCollapse(to);
+    for (unsigned int n : neighbours) {
+        PushBestCollapse(n);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool MeshSimplifier::Simplify(unsigned int targetFaces, double maxError) {
+    while (mNumFaces > targetFaces) {
+        if (mQueue.empty() || mQueue.top().mCost > maxError) {
+            return false;
+        }
+        const Collapse c = mQueue.top();
+        mQueue.pop();
+        if (!mVertexAlive[c.mFrom] || !mVertexAlive[c.mTo] || mStamps[c.mFrom] != c.mStamp) {
+            continue;
+        }
+        if (!IsValid(c.mFrom, c.mTo)) {
+            // Outdated by a collapse next to it, look for another target
+            PushBestCollapse(c.mFrom);
+            continue;
+        }
+        DoCollapse(c.mFrom, c.mTo);
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MeshSimplifier::GetIndices(std::vector<unsigned int> &out) const {
+    for (size_t f = 0; f < mFaceAlive.size(); ++f) {
+        if (mFaceAlive[f]) {
+            out.insert(out.end(), &mIndices[f * 3], &mIndices[f * 3] + 3);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+T *gatherArray(const T *pData, const std::vector<unsigned int> &order) {
+    if (nullptr == pData) {
+        return nullptr;
+    }
+    T *pOut = new T[order.size()];
+    for (size_t i = 0; i < order.size(); ++i) {
+        pOut[i] = pData[order[i]];
+    }
+    return pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+void gatherVertexData(T *pOut, const T *pMesh, const std::vector<unsigned int> &order) {
+    pOut->mNumVertices = static_cast<unsigned int>(order.size());
+    pOut->mVertices = gatherArray(pMesh->mVertices, order);
+    pOut->mNormals = gatherArray(pMesh->mNormals, order);
+    pOut->mTangents = gatherArray(pMesh->mTangents, order);
+    pOut->mBitangents = gatherArray(pMesh->mBitangents, order);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        pOut->mColors[i] = gatherArray(pMesh->mColors[i], order);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        pOut->mTextureCoords[i] = gatherArray(pMesh->mTextureCoords[i], order);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Creates a mesh from the given triangles, keeping only the vertices they refer to
+aiMesh *buildLevel(const aiMesh *pMesh, const std::vector<unsigned int> &indices, unsigned int level) {
+    std::vector<unsigned int> remap(pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> order;
+    for (unsigned int index : indices) {
+        if (remap[index] == UINT_MAX) {
+            remap[index] = static_cast<unsigned int>(order.size());
+            order.push_back(index);
+        }
+    }
+
+    aiMesh *pOut = new aiMesh();
+    pOut->mName.Set(std::string(pMesh->mName.C_Str()) + "_LOD" + std::to_string(level));
+    pOut->mMaterialIndex = pMesh->mMaterialIndex;
+    pOut->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    gatherVertexData(pOut, pMesh, order);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        pOut->mNumUVComponents[i] = pMesh->mNumUVComponents[i];
+        if (pMesh->HasTextureCoordsName(i)) {
+            pOut->SetTextureCoordsName(i, *pMesh->GetTextureCoordsName(i));
+        }
+    }
+
+    pOut->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
+    pOut->mFaces = new aiFace[pOut->mNumFaces];
+    for (unsigned int f = 0; f < pOut->mNumFaces; ++f) {
+        aiFace &face = pOut->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            face.mIndices[i] = remap[indices[f * 3 + i]];
+        }
+    }
+
+    // Bones which lost all of their weights are dropped
+    std::vector<aiBone *> bones;
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        const aiBone *pBone = pMesh->mBones[b];
+        std::vector<aiVertexWeight> weights;
+        for (unsigned int w = 0; w < pBone->mNumWeights; ++w) {
+            const unsigned int v = remap[pBone->mWeights[w].mVertexId];
+            if (v != UINT_MAX) {
+                weights.emplace_back(v, pBone->mWeights[w].mWeight);
+            }
+        }
+        if (weights.empty()) {
+            continue;
+        }
+        aiBone *pNewBone = new aiBone();
+        pNewBone->mName = pBone->mName;
+        pNewBone->mArmature = pBone->mArmature;
+        pNewBone->mNode = pBone->mNode;
+        pNewBone->mOffsetMatrix = pBone->mOffsetMatrix;
+        pNewBone->mNumWeights = static_cast<unsigned int>(weights.size());
+        pNewBone->mWeights = new aiVertexWeight[weights.size()];
+        std::copy(weights.begin(), weights.end(), pNewBone->mWeights);
+        bones.push_back(pNewBone);
+    }
+    if (!bones.empty()) {
+        pOut->mNumBones = static_cast<unsigned int>(bones.size());
+        pOut->mBones = new aiBone *[bones.size()];
+        std::copy(bones.begin(), bones.end(), pOut->mBones);
+    }
+
+    if (pMesh->mNumAnimMeshes > 0) {
+        pOut->mMethod = pMesh->mMethod;
+        pOut->mNumAnimMeshes = pMesh->mNumAnimMeshes;
+        pOut->mAnimMeshes = new aiAnimMesh *[pMesh->mNumAnimMeshes];
+        for (unsigned int a = 0; a < pMesh->mNumAnimMeshes; ++a) {
+            const aiAnimMesh *pAnim = pMesh->mAnimMeshes[a];
+            aiAnimMesh *pNewAnim = new aiAnimMesh();
+            pNewAnim->mName = pAnim->mName;
+            pNewAnim->mWeight = pAnim->mWeight;
+            gatherVertexData(pNewAnim, pAnim, order);
+            pOut->mAnimMeshes[a] = pNewAnim;
+        }
+    }
+
+    // Keep the bounding box up to date if aiProcess_GenBoundingBoxes ran before
+    if (pMesh->mAABB.mMin != pMesh->mAABB.mMax && pOut->mNumVertices > 0) {
+        pOut->mAABB.mMin = pOut->mAABB.mMax = pOut->mVertices[0];
+        for (unsigned int i = 1; i < pOut->mNumVertices; ++i) {
+            const aiVector3D &v = pOut->mVertices[i];
+            pOut->mAABB.mMin = aiVector3D(std::min(pOut->mAABB.mMin.x, v.x), std::min(pOut->mAABB.mMin.y, v.y), std::min(pOut->mAABB.mMin.z, v.z));
+            pOut->mAABB.mMax = aiVector3D(std::max(pOut->mAABB.mMax.x, v.x), std::max(pOut->mAABB.mMax.y, v.y), std::max(pOut->mAABB.mMax.z, v.z));
+        }
+    }
+    return pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Marks the meshes of nodes annotated by an earlier run, along with the levels they refer to.
+void markAnnotatedMeshes(const aiNode *pNode, std::vector<bool> &annotated) {
+    uint32_t numLevels = 0;
+    if (nullptr != pNode->mMetaData && pNode->mMetaData->Get(AI_METADATA_LOD_COUNT, numLevels)) {
+        for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+            annotated[pNode->mMeshes[i]] = true;
+        }
+        for (uint32_t level = 1; level <= numLevels; ++level) {
+            aiMetadata meshes;
+            if (!pNode->mMetaData->Get(AI_METADATA_LOD_LEVEL + std::to_string(level), meshes)) {
+                continue;
+            }
+            for (unsigned int i = 0; i < meshes.mNumProperties; ++i) {
+                uint32_t index = 0;
+                if (meshes.Get(i, index) && index < annotated.size()) {
+                    annotated[index] = true;
+                }
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i < pNode->mNumChildren; ++i) {
+        markAnnotatedMeshes(pNode->mChildren[i], annotated);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+GenLODsProcess::GenLODsProcess() :
+        mConfigLevels(0),
+        mConfigRatio(0.5f),
+        mConfigMaxError(0.02f) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenLODsProcess::IsActive(unsigned int) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::SetupProperties(const Importer *pImp) {
+    mConfigLevels = pImp->GetPropertyInteger(AI_CONFIG_PP_GLOD_LEVELS, 0);
+    mConfigRatio = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_RATIO, 0.5f);
+    mConfigMaxError = pImp->GetPropertyFloat(AI_CONFIG_PP_GLOD_MAX_ERROR, 0.02f);
+
+    if (mConfigRatio <= 0.f || mConfigRatio >= 1.f) {
+        ASSIMP_LOG_ERROR("GenLODsProcess: AI_CONFIG_PP_GLOD_RATIO is not in ]0,1[, using 0.5");
+        mConfigRatio = 0.5f;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::GenerateLevels(const aiMesh *pMesh, std::vector<aiMesh *> &levels) const {
+    // The ngon encoding of the source doesn't survive the simplification,
+    // the levels are plain triangle meshes
+    if ((pMesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) != aiPrimitiveType_TRIANGLE || pMesh->mNumFaces == 0) {
+        return;
+    }
+
+    aiVector3D min = pMesh->mVertices[0], max = pMesh->mVertices[0];
+    for (unsigned int i = 1; i < pMesh->mNumVertices; ++i) {
+        const aiVector3D &v = pMesh->mVertices[i];
+        min = aiVector3D(std::min(min.x, v.x), std::min(min.y, v.y), std::min(min.z, v.z));
+        max = aiVector3D(std::max(max.x, v.x), std::max(max.y, v.y), std::max(max.z, v.z));
+    }
+    const double maxError = mConfigMaxError * (max - min).Length();
+
+    // All levels come out of a single simplification run, so the error
+    // of each collapse is measured against the source mesh
+    MeshSimplifier simplifier(pMesh);
+    unsigned int numFaces = simplifier.GetNumFaces();
+    std::vector<unsigned int> indices;
+    for (unsigned int level = 1; level <= mConfigLevels; ++level) {
+        const bool finished = !simplifier.Simplify(static_cast<unsigned int>(numFaces * mConfigRatio), maxError * maxError);
+
+        // Stop the chain once a level doesn't pay off anymore
+        if (simplifier.GetNumFaces() == 0 || simplifier.GetNumFaces() > numFaces * 0.9f) {
+            break;
+        }
+        numFaces = simplifier.GetNumFaces();
+        indices.clear();
+        simplifier.GetIndices(indices);
+        levels.push_back(buildLevel(pMesh, indices, level));
+        if (finished) {
+            break;
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::Execute(aiScene *pScene) {
+    if (0 == mConfigLevels) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenLODsProcess begin");
+
+    // The levels of an earlier run are not simplified again and their nodes
+    // keep their chains, so applying the step twice leaves the scene as is
+    std::vector<bool> annotated(pScene->mNumMeshes, false);
+    markAnnotatedMeshes(pScene->mRootNode, annotated);
+
+    // lods[i] receives the indices of the levels generated for mesh i
+    std::vector<std::vector<unsigned int> > lods(pScene->mNumMeshes);
+    std::vector<aiMesh *> newMeshes, levels;
+    unsigned int numFaces = 0, numLodFaces = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (annotated[i]) {
+            continue;
+        }
+        levels.clear();
+        GenerateLevels(pScene->mMeshes[i], levels);
+        for (aiMesh *pLevel : levels) {
+            lods[i].push_back(pScene->mNumMeshes + static_cast<unsigned int>(newMeshes.size()));
+            newMeshes.push_back(pLevel);
+        }
+        if (!levels.empty()) {
+            numFaces += pScene->mMeshes[i]->mNumFaces;
+            numLodFaces += levels.back()->mNumFaces;
+        }
+    }
+
+    if (newMeshes.empty()) {
+        ASSIMP_LOG_DEBUG("GenLODsProcess finished. No mesh could be simplified");
+        return;
+    }
+
+    aiMesh **ppMeshes = new aiMesh *[pScene->mNumMeshes + newMeshes.size()];
+    std::copy(pScene->mMeshes, pScene->mMeshes + pScene->mNumMeshes, ppMeshes);
+    std::copy(newMeshes.begin(), newMeshes.end(), ppMeshes + pScene->mNumMeshes);
+    delete[] pScene->mMeshes;
+    pScene->mMeshes = ppMeshes;
+    pScene->mNumMeshes += static_cast<unsigned int>(newMeshes.size());
+
+    AnnotateNode(pScene->mRootNode, lods);
+
+    if (!DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_INFO("GenLODsProcess finished. Generated ", newMeshes.size(),
+                " levels, the coarsest ones have ", numLodFaces, " of ", numFaces, " faces");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenLODsProcess::AnnotateNode(aiNode *pNode, const std::vector<std::vector<unsigned int> > &lods) const {
+    size_t numLevels = 0;
+    for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+        numLevels = std::max(numLevels, lods[pNode->mMeshes[i]].size());
+    }
+
+    if (numLevels > 0) {
+        if (nullptr == pNode->mMetaData) {
+            pNode->mMetaData = new aiMetadata();
+        }
+        pNode->mMetaData->Add(AI_METADATA_LOD_COUNT, static_cast<uint32_t>(numLevels));
+
+        // Meshes with a shorter chain keep using their coarsest level
+        for (size_t level = 1; level <= numLevels; ++level) {
+            aiMetadata meshes;
+            for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+                const std::vector<unsigned int> &chain = lods[pNode->mMeshes[i]];
+                const unsigned int index = chain.empty() ? pNode->mMeshes[i] : chain[std::min(level, chain.size()) - 1];
+                meshes.Add(std::to_string(i), static_cast<uint32_t>(index));
+            }
+            pNode->mMetaData->Add(AI_METADATA_LOD_LEVEL + std::to_string(level), meshes);
+        }
+    }
+
+    for (unsigned int i = 0; i < pNode->mNumChildren; ++i) {
+        AnnotateNode(pNode->mChildren[i], lods);
+    }
+}
+
+} // namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_GENLODS_PROCESS
@@ -0,0 +1,128 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to generate simplified levels of
+ *        detail for all triangle meshes.
+ */
+#pragma once
+#ifndef AI_GENLODSPROCESS_H_INC
+#define AI_GENLODSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <vector>
+
+struct aiMesh;
+struct aiNode;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenLODsProcess builds a chain of simplified copies of each triangle
+ *  mesh using quadric error metrics. The simplified meshes are appended to
+ *  the scene's mesh list and the nodes referencing the source mesh are
+ *  annotated with #AI_METADATA_LOD_COUNT and #AI_METADATA_LOD_LEVEL entries.
+ *
+ *  There is no aiPostProcessSteps flag left for this step, it is enabled by
+ *  setting #AI_CONFIG_PP_GLOD_LEVELS to a non-zero value instead.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenLODsProcess : public BaseProcess {
+public:
+    // -------------------------------------------------------------------
+    /// The default class constructor / destructor.
+    GenLODsProcess();
+    ~GenLODsProcess() override = default;
+
+    // -------------------------------------------------------------------
+    /// @brief Always returns false, the step is driven by
+    ///        #AI_CONFIG_PP_GLOD_LEVELS rather than by a flag.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    /// @brief The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    // -------------------------------------------------------------------
+    /// @brief Reads the AI_CONFIG_PP_GLOD_XXX properties.
+    void SetupProperties(const Importer* pImp) override;
+
+    // -------------------------------------------------------------------
+    /** @brief Simplifies a single mesh.
+     *  @param pMesh The source mesh, must consist of triangles only.
+     *  @param levels Receives the generated levels, coarsest last.
+     *    Each level has at most mConfigRatio times the faces of the
+     *    previous one.
+     */
+    void GenerateLevels(const aiMesh* pMesh, std::vector<aiMesh*>& levels) const;
+
+    // -------------------------------------------------------------------
+    /// Setters for the configuration, mainly for the unit tests.
+    void SetNumLevels(unsigned int levels) { mConfigLevels = levels; }
+    void SetRatio(float ratio) { mConfigRatio = ratio; }
+    void SetMaxError(float error) { mConfigMaxError = error; }
+
+private:
+    // -------------------------------------------------------------------
+    /// Adds the LOD metadata to a node and its children.
+    void AnnotateNode(aiNode* pNode, const std::vector<std::vector<unsigned int> >& lods) const;
+
+    //! Configuration parameter: number of levels to generate per mesh.
+    unsigned int mConfigLevels;
+
+    //! Configuration parameter: face count of a level relative
+    //! to the previous one.
+    float mConfigRatio;
+
+    //! Configuration parameter: maximum geometric error relative
+    //! to the diagonal of the mesh's bounding box.
+    float mConfigMaxError;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENLODS_PROCESS
+
+#endif // AI_GENLODSPROCESS_H_INC
@@ -0,0 +1,258 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Implementation of the post processing step to generate meshlets.
+ * <br>
+ * Meshlets are grown greedily: starting with the first free face in the
+ * current face order, the meshlet is extended by the adjacent face which
+ * adds the fewest new vertices until one of the limits is reached. If no
+ * adjacent face is left, the next free face in face order is used, which
+ * works best if #aiProcess_ImproveCacheLocality ran before.
+ */
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "Common/VertexTriangleAdjacency.h"
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/DefaultLogger.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+// Computes the bounding volumes and the normal cone of a meshlet
+static void computeBounds(const aiMesh *pMesh, const unsigned int *pIndices,
+        const std::vector<unsigned int> &vertices, aiMeshlet &meshlet) {
+    aiAABB &box = meshlet.mAABB;
+    box.mMin = box.mMax = pMesh->mVertices[vertices[0]];
+    for (unsigned int v : vertices) {
+        const aiVector3D &p = pMesh->mVertices[v];
+        box.mMin = aiVector3D(std::min(box.mMin.x, p.x), std::min(box.mMin.y, p.y), std::min(box.mMin.z, p.z));
+        box.mMax = aiVector3D(std::max(box.mMax.x, p.x), std::max(box.mMax.y, p.y), std::max(box.mMax.z, p.z));
+    }
+    meshlet.mCenter = (box.mMin + box.mMax) * static_cast<ai_real>(0.5);
+    meshlet.mRadius = 0;
+    for (unsigned int v : vertices) {
+        meshlet.mRadius = std::max(meshlet.mRadius, (pMesh->mVertices[v] - meshlet.mCenter).Length());
+    }
+
+    // The cone axis is the average of the face normals, the cutoff the
+    // cosine of the largest angle between the axis and a face normal
+    std::vector<aiVector3D> normals;
+    normals.reserve(meshlet.mNumFaces);
+    aiVector3D axis;
+    for (unsigned int f = 0; f < meshlet.mNumFaces; ++f) {
+        const unsigned int *tri = pIndices + (meshlet.mFaceOffset + f) * 3;
+        const aiVector3D &p0 = pMesh->mVertices[tri[0]];
+        aiVector3D n = (pMesh->mVertices[tri[1]] - p0) ^ (pMesh->mVertices[tri[2]] - p0);
+        const ai_real len = n.Length();
+        if (len > 0) {
+            n /= len;
+            normals.push_back(n);
+            axis += n;
+        }
+    }
+
+    const ai_real len = axis.Length();
+    meshlet.mConeCutoff = -1;
+    if (len > static_cast<ai_real>(1e-6)) {
+        meshlet.mConeAxis = axis / len;
+        meshlet.mConeCutoff = 1;
+        for (const aiVector3D &n : normals) {
+            meshlet.mConeCutoff = std::min(meshlet.mConeCutoff, n * meshlet.mConeAxis);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+GenMeshletsProcess::GenMeshletsProcess() :
+        mConfigMaxVertices(0),
+        mConfigMaxTriangles(124) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::IsActive(unsigned int) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::SetupProperties(const Importer *pImp) {
+    mConfigMaxVertices = pImp->GetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_VERTICES, 0);
+    mConfigMaxTriangles = pImp->GetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_TRIANGLES, 124);
+}
+
+// ------------------------------------------------------------------------------------------------
+void GenMeshletsProcess::Execute(aiScene *pScene) {
+    if (0 == mConfigMaxVertices) {
+        return;
+    }
+    ASSIMP_LOG_DEBUG("GenMeshletsProcess begin");
+
+    unsigned int numMeshlets = 0, numFaces = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (ProcessMesh(pScene->mMeshes[i])) {
+            numMeshlets += pScene->mMeshes[i]->mNumMeshlets;
+            numFaces += pScene->mMeshes[i]->mNumFaces;
+        }
+    }
+
+    if (!DefaultLogger::isNullLogger()) {
+        ASSIMP_LOG_INFO("GenMeshletsProcess finished. Generated ", numMeshlets, " meshlets with ",
+                numMeshlets ? static_cast<float>(numFaces) / numMeshlets : 0.f, " faces on average");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+bool GenMeshletsProcess::ProcessMesh(aiMesh *pMesh) const {
+    if ((pMesh->mPrimitiveTypes & ~aiPrimitiveType_NGONEncodingFlag) != aiPrimitiveType_TRIANGLE || 0 == pMesh->mNumFaces) {
+        return false;
+    }
+
+    // Keep the meshlets of an earlier run as long as they still cover all faces
+    if (pMesh->HasMeshlets()) {
+        const aiMeshlet &last = pMesh->mMeshlets[pMesh->mNumMeshlets - 1];
+        if (last.mFaceOffset + last.mNumFaces == pMesh->mNumFaces) {
+            return false;
+        }
+    }
+
+    // A vertex limit below 3 would not even hold a single face, more than 256
+    // vertices can't be addressed with byte indices anymore
+    const unsigned int maxVertices = std::min(std::max(mConfigMaxVertices, 3u), 256u);
+    const unsigned int maxTriangles = std::max(mConfigMaxTriangles, 1u);
+
+    const unsigned int numFaces = pMesh->mNumFaces;
+    VertexTriangleAdjacency adj(pMesh->mFaces, numFaces, pMesh->mNumVertices, true);
+    std::vector<unsigned int> numAdjacent(adj.mLiveTriangles, adj.mLiveTriangles + pMesh->mNumVertices);
+
+    std::vector<bool> emitted(numFaces, false);
+    std::vector<unsigned int> mark(pMesh->mNumVertices, UINT_MAX);
+    std::vector<unsigned int> indices;
+    indices.reserve(numFaces * 3);
+    std::vector<unsigned int> vertices;
+    std::vector<aiMeshlet> meshlets;
+
+    unsigned int next = 0;
+    while (indices.size() < numFaces * 3) {
+        const unsigned int id = static_cast<unsigned int>(meshlets.size());
+        aiMeshlet meshlet;
+        meshlet.mFaceOffset = static_cast<unsigned int>(indices.size() / 3);
+        vertices.clear();
+
+        while (meshlet.mNumFaces < maxTriangles) {
+            // Look for the adjacent face adding the fewest vertices
+            unsigned int best = UINT_MAX, bestNew = 4;
+            for (size_t i = 0; i < vertices.size() && bestNew; ++i) {
+                const unsigned int v = vertices[i];
+                if (!adj.mLiveTriangles[v]) {
+                    continue;
+                }
+                const unsigned int *faces = adj.GetAdjacentTriangles(v);
+                for (unsigned int j = 0; j < numAdjacent[v]; ++j) {
+                    if (emitted[faces[j]]) {
+                        continue;
+                    }
+                    const unsigned int *tri = pMesh->mFaces[faces[j]].mIndices;
+                    const unsigned int numNew = (mark[tri[0]] != id) + (mark[tri[1]] != id) + (mark[tri[2]] != id);
+                    if (numNew < bestNew) {
+                        best = faces[j];
+                        bestNew = numNew;
+                    }
+                }
+            }
+            if (best == UINT_MAX) {
+                while (emitted[next]) {
+                    ++next;
+                }
+                best = next;
+                const unsigned int *tri = pMesh->mFaces[best].mIndices;
+                bestNew = (mark[tri[0]] != id) + (mark[tri[1]] != id) + (mark[tri[2]] != id);
+            }
+            if (vertices.size() + bestNew > maxVertices) {
+                break;
+            }
+
+            emitted[best] = true;
+            ++meshlet.mNumFaces;
+            const unsigned int *tri = pMesh->mFaces[best].mIndices;
+            for (unsigned int i = 0; i < 3; ++i) {
+                indices.push_back(tri[i]);
+                --adj.mLiveTriangles[tri[i]];
+                if (mark[tri[i]] != id) {
+                    mark[tri[i]] = id;
+                    vertices.push_back(tri[i]);
+                }
+            }
+            if (indices.size() == numFaces * 3) {
+                break;
+            }
+        }
+
+        meshlet.mNumVertices = static_cast<unsigned int>(vertices.size());
+        computeBounds(pMesh, indices.data(), vertices, meshlet);
+        meshlets.push_back(meshlet);
+    }
+
+    // Write the faces back in meshlet order. The ngon encoding relies on the
+    // original order of the faces, so it's lost.
+    for (unsigned int f = 0; f < numFaces; ++f) {
+        std::copy(&indices[f * 3], &indices[f * 3] + 3, pMesh->mFaces[f].mIndices);
+    }
+    pMesh->mPrimitiveTypes &= ~aiPrimitiveType_NGONEncodingFlag;
+
+    delete[] pMesh->mMeshlets;
+    pMesh->mNumMeshlets = static_cast<unsigned int>(meshlets.size());
+    pMesh->mMeshlets = new aiMeshlet[meshlets.size()];
+    std::copy(meshlets.begin(), meshlets.end(), pMesh->mMeshlets);
+    return true;
+}
+
+} // namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
@@ -0,0 +1,114 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+/** @file Defines a post-processing step to group the faces of all triangle
+ *        meshes into meshlets.
+ */
+#pragma once
+#ifndef AI_GENMESHLETSPROCESS_H_INC
+#define AI_GENMESHLETSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+struct aiMesh;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** The GenMeshletsProcess partitions the faces of each triangle mesh into
+ *  clusters of adjacent triangles with a bounded number of vertices and
+ *  faces. The faces are sorted by meshlet and the bounds and normal cone of
+ *  each meshlet are stored in aiMesh::mMeshlets.
+ *
+ *  There is no aiPostProcessSteps flag left for this step, it is enabled by
+ *  setting #AI_CONFIG_PP_MESHLET_MAX_VERTICES to a non-zero value instead.
+ *
+ *  @note This step expects triangulated input data.
+ */
+class ASSIMP_API GenMeshletsProcess : public BaseProcess {
+public:
+    // -------------------------------------------------------------------
+    /// The default class constructor / destructor.
+    GenMeshletsProcess();
+    ~GenMeshletsProcess() override = default;
+
+    // -------------------------------------------------------------------
+    /// @brief Always returns false, the step is driven by
+    ///        #AI_CONFIG_PP_MESHLET_MAX_VERTICES rather than by a flag.
+    bool IsActive(unsigned int pFlags) const override;
+
+    // -------------------------------------------------------------------
+    /// @brief The execution callback.
+    void Execute(aiScene* pScene) override;
+
+    // -------------------------------------------------------------------
+    /// @brief Reads the AI_CONFIG_PP_MESHLET_XXX properties.
+    void SetupProperties(const Importer* pImp) override;
+
+    // -------------------------------------------------------------------
+    /** @brief Builds the meshlets of a single mesh.
+     *  @param pMesh The mesh, meshes with other primitives than
+     *    triangles are left untouched.
+     *  @return true if the mesh has been processed.
+     */
+    bool ProcessMesh(aiMesh* pMesh) const;
+
+    // -------------------------------------------------------------------
+    /// Setters for the configuration, mainly for the unit tests.
+    void SetMaxVertices(unsigned int vertices) { mConfigMaxVertices = vertices; }
+    void SetMaxTriangles(unsigned int triangles) { mConfigMaxTriangles = triangles; }
+
+private:
+    //! Configuration parameter: vertex limit per meshlet.
+    unsigned int mConfigMaxVertices;
+
+    //! Configuration parameter: face limit per meshlet.
+    unsigned int mConfigMaxTriangles;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_GENMESHLETS_PROCESS
+
+#endif // AI_GENMESHLETSPROCESS_H_INC
@@ -47,7 +47,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
 #include <assimp/Exceptional.h>
-#include <assimp/qnan.h>
 
 using namespace Assimp;
 
@@ -118,19 +117,14 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         return false;
     }
 
-    // Allocate the array to hold the output normals
-    const float qnan = std::numeric_limits<ai_real>::quiet_NaN();
-    pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
-
-    // Compute per-face normals but store them per-vertex
+    // Compute the normal of every face. Points and lines have none. Besides the
+    // unit normal used for the angle test, keep the unnormalized normal of the
+    // polygon, whose length is twice its area.
+    std::vector<aiVector3D> faceNormals(pMesh->mNumFaces), faceAreaNormals(pMesh->mNumFaces);
+    std::vector<unsigned int> vertexFaceStart(pMesh->mNumVertices + 1, 0);
     for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         const aiFace &face = pMesh->mFaces[a];
         if (face.mNumIndices < 3) {
-            // either a point or a line -> no normal vector
-            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-                pMesh->mNormals[face.mIndices[i]] = aiVector3D(qnan);
-            }
-
             continue;
         }
 
@@ -139,13 +133,48 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         const aiVector3D *pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
         // Boolean XOR - if either but not both of these flags is set, then the winding order has
         // changed and the cross product to calculate the normal needs to be reversed
-        if (flippedWindingOrder_ != leftHanded_) {
+        const bool flip = flippedWindingOrder_ != leftHanded_;
+        if (flip) {
             std::swap(pV2, pV3);
         }
-        const aiVector3D vNor = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
+        faceNormals[a] = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
+
+        aiVector3D vArea;
+        for (unsigned int i = 2; i < face.mNumIndices; ++i) {
+            vArea += (pMesh->mVertices[face.mIndices[i - 1]] - *pV1) ^ (pMesh->mVertices[face.mIndices[i]] - *pV1);
+        }
+        faceAreaNormals[a] = flip ? -vArea : vArea;
 
         for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-            pMesh->mNormals[face.mIndices[i]] = vNor;
+            ++vertexFaceStart[face.mIndices[i] + 1];
+        }
+    }
+
+    // Scatter the face normals through the index buffer to get the area weighted
+    // normal of each vertex. In verbose meshes every vertex belongs to one polygon
+    // at most and simply takes its normal, meshes with shared vertices are indexed.
+    bool bIndexed = false;
+    aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
+    for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+        const aiFace &face = pMesh->mFaces[a];
+        if (face.mNumIndices < 3) {
+            continue;
+        }
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int idx = face.mIndices[i];
+            if (vertexFaceStart[idx + 1] == 1) {
+                pcNew[idx] = faceNormals[a];
+            } else {
+                pcNew[idx] += faceAreaNormals[a];
+                bIndexed = true;
+            }
+        }
+    }
+    if (bIndexed) {
+        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+            if (vertexFaceStart[i + 1] > 1) {
+                pcNew[i].NormalizeSafe();
+            }
         }
     }
 
@@ -163,13 +192,25 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
             posEpsilon = blubb.second;
         }
     }
+    if (!vertexFinder) {
+        posEpsilon = ComputePositionEpsilon(pMesh);
+    }
+
+    // Without an angle limit, the index buffer of a welded mesh already tells
+    // which faces share a vertex, so no positional search is needed. Vertices
+    // within posEpsilon of each other, e.g. along UV seams or split polygons
+    // of verbose meshes, still need to be smoothed by position.
+    if (bIndexed && configMaxAngle >= AI_DEG_TO_RAD(175.f) && HasUniquePositions(pMesh, posEpsilon)) {
+        pMesh->mNormals = pcNew;
+        return true;
+    }
+
     if (!vertexFinder) {
         _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
         vertexFinder = &_vertexFinder;
-        posEpsilon = ComputePositionEpsilon(pMesh);
     }
     std::vector<unsigned int> verticesFound;
-    aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
+    aiVector3D *pcSmooth = new aiVector3D[pMesh->mNumVertices];
 
     if (configMaxAngle >= AI_DEG_TO_RAD(175.f)) {
         // There is no angle limit. Thus all vertices with positions close
@@ -186,15 +227,14 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
 
             aiVector3D pcNor;
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                const aiVector3D &v = pMesh->mNormals[verticesFound[a]];
-                if (is_not_qnan(v.x)) pcNor += v;
+                pcNor += pcNew[verticesFound[a]];
             }
             pcNor.NormalizeSafe();
 
             // Write the smoothed normal back to all affected normals
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
                 unsigned int vidx = verticesFound[a];
-                pcNew[vidx] = pcNor;
+                pcSmooth[vidx] = pcNor;
                 abHad[vidx] = true;
             }
         }
@@ -202,29 +242,56 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
     // Slower code path if a smooth angle is set. There are many ways to achieve
     // the effect, this one is the most straightforward one.
     else {
+        // Per vertex, the polygons referencing it
+        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+            vertexFaceStart[i + 1] += vertexFaceStart[i];
+        }
+        std::vector<unsigned int> vertexFaces(vertexFaceStart.back());
+        std::vector<unsigned int> vertexFaceCursor(vertexFaceStart.begin(), vertexFaceStart.end() - 1);
+        for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
+            const aiFace &face = pMesh->mFaces[a];
+            if (face.mNumIndices >= 3) {
+                for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                    vertexFaces[vertexFaceCursor[face.mIndices[i]]++] = a;
+                }
+            }
+        }
+
         const ai_real fLimit = std::cos(configMaxAngle);
         for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
             // Get all vertices that share this one ...
             vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
 
-            aiVector3D vr = pMesh->mNormals[i];
-
             aiVector3D pcNor;
             for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                aiVector3D v = pMesh->mNormals[verticesFound[a]];
-
-                // Check whether the angle between the two normals is not too large.
-                // Skip the angle check on our own normal to avoid false negatives
-                // (v*v is not guaranteed to be 1.0 for all unit vectors v)
-                if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
-                    pcNor += v;
+                const unsigned int vidx = verticesFound[a];
+                if (vidx == i) {
+                    pcNor += pcNew[i];
+                    continue;
+                }
+
+                // Each vertex contributes the faces whose normal is within the angle
+                // limit of one of the faces of this vertex. Our own faces are never
+                // tested to avoid false negatives (v*v is not guaranteed to be 1.0
+                // for all unit vectors v)
+                aiVector3D v;
+                for (unsigned int f = vertexFaceStart[vidx]; f < vertexFaceStart[vidx + 1]; ++f) {
+                    const unsigned int face = vertexFaces[f];
+                    for (unsigned int o = vertexFaceStart[i]; o < vertexFaceStart[i + 1]; ++o) {
+                        if (faceNormals[face] * faceNormals[vertexFaces[o]] >= fLimit) {
+                            v += faceAreaNormals[face];
+                            break;
+                        }
+                    }
+                }
+                pcNor += v.NormalizeSafe();
             }
-            pcNew[i] = pcNor.NormalizeSafe();
+            pcSmooth[i] = pcNor.NormalizeSafe();
         }
     }
 
-    delete[] pMesh->mNormals;
-    pMesh->mNormals = pcNew;
+    delete[] pcNew;
+    pMesh->mNormals = pcSmooth;
 
     return true;
 }
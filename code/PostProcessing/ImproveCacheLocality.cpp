@@ -41,9 +41,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /** @file Implementation of the post processing step to improve the cache locality of a mesh.
  * <br>
- * The algorithm is roughly basing on this paper:
+ * The default algorithm is roughly basing on this paper:
  * http://www.cs.princeton.edu/gfx/pubs/Sander_2007_%3ETR/tipsy.pdf
  *   .. although overdraw reduction isn't implemented yet ...
+ * Alternatively the LRU cache scoring of Tom Forsyth's "Linear-Speed Vertex
+ * Cache Optimisation" can be used.
  */
 
 // internal headers
@@ -54,6 +56,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
+#include <climits>
+#include <cmath>
 #include <stdio.h>
 #include <stack>
 
@@ -62,7 +67,9 @@ namespace Assimp {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ImproveCacheLocalityProcess::ImproveCacheLocalityProcess() :
-        mConfigCacheDepth(PP_ICL_PTCACHE_SIZE) {
+        mConfigCacheDepth(PP_ICL_PTCACHE_SIZE),
+        mConfigMethod(AI_ICL_METHOD_TIPSIFY),
+        mConfigReorderVertices(false) {
     // empty
 }
 
@@ -77,6 +84,12 @@ bool ImproveCacheLocalityProcess::IsActive(unsigned int pFlags) const {
 void ImproveCacheLocalityProcess::SetupProperties(const Importer *pImp) {
     // AI_CONFIG_PP_ICL_PTCACHE_SIZE controls the target cache size for the optimizer
     mConfigCacheDepth = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE, PP_ICL_PTCACHE_SIZE);
+
+    // AI_CONFIG_PP_ICL_METHOD selects the optimizer
+    mConfigMethod = pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_METHOD, AI_ICL_METHOD_TIPSIFY);
+
+    // AI_CONFIG_PP_ICL_REORDER_VERTICES enables the vertex fetch optimization
+    mConfigReorderVertices = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_ICL_REORDER_VERTICES, 0));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -90,111 +103,53 @@ void ImproveCacheLocalityProcess::Execute(aiScene *pScene) {
     ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess begin");
 
     float out = 0.f;
-    unsigned int numf = 0, numm = 0;
+    unsigned int numf = 0, numv = 0, numm = 0;
     for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
         const float res = ProcessMesh(pScene->mMeshes[a], a);
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
+            numv += pScene->mMeshes[a]->mNumVertices;
             out += res;
             ++numm;
         }
     }
     if (!DefaultLogger::isNullLogger()) {
         if (numf > 0) {
-            ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf);
+            ASSIMP_LOG_INFO("Cache relevant are ", numm, " meshes (", numf, " faces). Average output ACMR is ", out / numf,
+                    ", ATVR is ", out / numv);
         }
         ASSIMP_LOG_DEBUG("ImproveCacheLocalityProcess finished. ");
     }
 }
 
 // ------------------------------------------------------------------------------------------------
-static ai_real calculateInputACMR(aiMesh *pMesh, const aiFace *const pcEnd,
-        unsigned int configCacheDepth, unsigned int meshNum) {
-    ai_real fACMR = 0.0f;
-    unsigned int *piFIFOStack = new unsigned int[configCacheDepth];
-    memset(piFIFOStack, 0xff, configCacheDepth * sizeof(unsigned int));
-    unsigned int *piCur = piFIFOStack;
-    const unsigned int *const piCurEnd = piFIFOStack + configCacheDepth;
-
-    // count the number of cache misses
+// Simulates a FIFO vertex cache and returns the number of cache misses for the index buffer
+// of the mesh. A vertex is evicted as soon as configCacheDepth other vertices were loaded.
+static unsigned int countCacheMisses(const aiMesh *pMesh, unsigned int configCacheDepth) {
+    std::vector<unsigned int> piStamps(pMesh->mNumVertices, 0);
     unsigned int iCacheMisses = 0;
+
+    const aiFace *const pcEnd = pMesh->mFaces + pMesh->mNumFaces;
     for (const aiFace *pcFace = pMesh->mFaces; pcFace != pcEnd; ++pcFace) {
-        for (unsigned int qq = 0; qq < 3; ++qq) {
-            bool bInCache = false;
-            for (unsigned int *pp = piFIFOStack; pp < piCurEnd; ++pp) {
-                if (*pp == pcFace->mIndices[qq]) {
-                    // the vertex is in cache
-                    bInCache = true;
-                    break;
-                }
-            }
-            if (!bInCache) {
-                ++iCacheMisses;
-                if (piCurEnd == piCur) {
-                    piCur = piFIFOStack;
-                }
-                *piCur++ = pcFace->mIndices[qq];
+        for (unsigned int qq = 0; qq < pcFace->mNumIndices; ++qq) {
+            unsigned int &iStamp = piStamps[pcFace->mIndices[qq]];
+            if (!iStamp || iCacheMisses - iStamp >= configCacheDepth) {
+                iStamp = ++iCacheMisses;
             }
         }
     }
-    delete[] piFIFOStack;
-    fACMR = (ai_real)iCacheMisses / pMesh->mNumFaces;
-    if (3.0 == fACMR) {
-        char szBuff[128]; // should be sufficiently large in every case
-
-        // the JoinIdenticalVertices process has not been executed on this
-        // mesh, otherwise this value would normally be at least minimally
-        // smaller than 3.0 ...
-        ai_snprintf(szBuff, 128, "Mesh %u: Not suitable for vcache optimization", meshNum);
-        ASSIMP_LOG_WARN(szBuff);
-        return static_cast<ai_real>(0.f);
-    }
-    return fACMR;
+    return iCacheMisses;
 }
 
 // ------------------------------------------------------------------------------------------------
-// Improves the cache coherency of a specific mesh
-ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshNum) {
-    // TODO: rewrite this to use std::vector or boost::shared_array
-    ai_assert(nullptr != pMesh);
-
-    // Check whether the input data is valid
-    // - there must be vertices and faces
-    // - all faces must be triangulated or we can't operate on them
-    if (!pMesh->HasFaces() || !pMesh->HasPositions())
-        return static_cast<ai_real>(0.f);
-
-    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
-        ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
-        return static_cast<ai_real>(0.f);
-    }
-
-    if (pMesh->mNumVertices <= mConfigCacheDepth) {
-        return static_cast<ai_real>(0.f);
-    }
-
-    ai_real fACMR = 3.f;
-    const aiFace *const pcEnd = pMesh->mFaces + pMesh->mNumFaces;
-
-    // Input ACMR is for logging purposes only
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR = calculateInputACMR(pMesh, pcEnd, mConfigCacheDepth, meshNum);
-    }
-
-    // first we need to build a vertex-triangle adjacency list
-    VertexTriangleAdjacency adj(pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, true);
-
+// Tipsify, see the paper referenced above
+static void optimizeTipsify(const aiMesh *pMesh, VertexTriangleAdjacency &adj,
+        unsigned int configCacheDepth, std::vector<unsigned int> &piIBOutput) {
     // build a list to store per-vertex caching time stamps
     std::vector<unsigned int> piCachingStamps;
     piCachingStamps.resize(pMesh->mNumVertices);
     memset(&piCachingStamps[0], 0x0, pMesh->mNumVertices * sizeof(unsigned int));
 
-    // allocate an empty output index buffer. We store the output indices in one large array.
-    // Since the number of triangles won't change the input faces can be reused. This is how
-    // we save thousands of redundant mini allocations for aiFace::mIndices
-    const unsigned int iIdxCnt = pMesh->mNumFaces * 3;
-    std::vector<unsigned int> piIBOutput;
-    piIBOutput.resize(iIdxCnt);
     std::vector<unsigned int>::iterator piCSIter = piIBOutput.begin();
 
     // allocate the flag array to hold the information
@@ -220,7 +175,6 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
     ai_assert(iMaxRefTris > 0);
     std::vector<unsigned int> piCandidates;
     piCandidates.resize(iMaxRefTris * 3);
-    unsigned int iCacheMisses = 0;
 
     // ...................................................................................
     /** PSEUDOCODE for the algorithm
@@ -254,7 +208,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
 
     int ivdx = 0;
     int ics = 1;
-    int iStampCnt = mConfigCacheDepth + 1;
+    int iStampCnt = configCacheDepth + 1;
     while (ivdx >= 0) {
 
         unsigned int icnt = piNumTriPtrNoModify[ivdx];
@@ -290,9 +244,8 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
                     *piCSIter++ = dp;
 
                     // if the vertex is not yet in cache, set its cache count
-                    if (iStampCnt - piCachingStamps[dp] > mConfigCacheDepth) {
+                    if (iStampCnt - piCachingStamps[dp] > configCacheDepth) {
                         piCachingStamps[dp] = iStampCnt++;
-                        ++iCacheMisses;
                     }
                 }
                 // flag triangle as emitted
@@ -315,7 +268,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
 
                 // will the vertex be in cache, even after fanning occurs?
                 unsigned int tmp;
-                if ((tmp = iStampCnt - piCachingStamps[dp]) + 2 * piNumTriPtr[dp] <= mConfigCacheDepth) {
+                if ((tmp = iStampCnt - piCachingStamps[dp]) + 2 * piNumTriPtr[dp] <= configCacheDepth) {
                     priority = tmp;
                 }
 
@@ -342,7 +295,7 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
             if (-1 == ivdx) {
                 // well, there isn't such a vertex. Simply get the next vertex in input order and
                 // hope it is not too bad ...
-                while (ics < (int)pMesh->mNumVertices) {
+                while (ics + 1 < (int)pMesh->mNumVertices) {
                     ++ics;
                     if (piNumTriPtr[ics] > 0) {
                         ivdx = ics;
@@ -352,19 +305,251 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
             }
         }
     }
-    ai_real fACMR2 = 0.0f;
-    if (!DefaultLogger::isNullLogger()) {
-        fACMR2 = static_cast<ai_real>(iCacheMisses / pMesh->mNumFaces);
-        const ai_real averageACMR = ((fACMR - fACMR2) / fACMR) * 100.f;
-        // very intense verbose logging ... prepare for much text if there are many meshes
-        if (DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
-            ASSIMP_LOG_VERBOSE_DEBUG("Mesh ", meshNum, "| ACMR in: ", fACMR, " out: ", fACMR2, " | average ACMR ", averageACMR);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Vertex score of Forsyth's algorithm: vertices in the LRU cache and vertices with only a few
+// triangles left are preferred. Vertices without any triangles left are no candidates.
+static float forsythVertexScore(int iCachePos, unsigned int iLiveTris, unsigned int configCacheDepth) {
+    static const float fCacheDecayPower = 1.5f;
+    static const float fLastTriScore = 0.75f;
+    static const float fValenceBoostScale = 2.0f;
+    static const float fValenceBoostPower = 0.5f;
+
+    if (0 == iLiveTris) {
+        return -1.f;
+    }
+
+    float fScore = 0.f;
+    if (iCachePos >= 0) {
+        if (iCachePos < 3) {
+            // the vertices of the last triangle get a fixed score, no matter which
+            // of them is used next we want to stay with the current fan
+            fScore = fLastTriScore;
+        } else {
+            const float fScaler = 1.f / (configCacheDepth - 3);
+            fScore = std::pow(1.f - (iCachePos - 3) * fScaler, fCacheDecayPower);
         }
-        fACMR2 *= pMesh->mNumFaces;
+    }
+    return fScore + fValenceBoostScale * std::pow(static_cast<float>(iLiveTris), -fValenceBoostPower);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Forsyth's "Linear-Speed Vertex Cache Optimisation": greedily emit the triangle with the best
+// score, only triangles touching the simulated LRU cache are rescored after each step.
+static void optimizeForsyth(const aiMesh *pMesh, VertexTriangleAdjacency &adj,
+        unsigned int configCacheDepth, std::vector<unsigned int> &piIBOutput) {
+    // the scoring function needs more cache entries than the last triangle
+    configCacheDepth = std::max(configCacheDepth, 4u);
+
+    const unsigned int iNumVertices = pMesh->mNumVertices;
+    const unsigned int iNumFaces = pMesh->mNumFaces;
+    unsigned int *const piNumTriPtr = adj.mLiveTriangles;
+    const std::vector<unsigned int> piNumTriPtrNoModify(piNumTriPtr, piNumTriPtr + iNumVertices);
+
+    std::vector<int> piCachePos(iNumVertices, -1);
+    std::vector<float> pfVertexScore(iNumVertices);
+    for (unsigned int v = 0; v < iNumVertices; ++v) {
+        pfVertexScore[v] = forsythVertexScore(-1, piNumTriPtr[v], configCacheDepth);
+    }
+
+    std::vector<bool> abEmitted(iNumFaces, false);
+
+    // the LRU cache, most recently used vertex first. The vertices of the
+    // emitted triangle are temporarily stored in excess of the cache size.
+    std::vector<unsigned int> piCache, piNewCache;
+    piCache.reserve(configCacheDepth + 3);
+    piNewCache.reserve(configCacheDepth + 3);
+
+    std::vector<unsigned int>::iterator piCSIter = piIBOutput.begin();
+    unsigned int iBestFace = UINT_MAX, iNextFace = 0;
+    for (unsigned int n = 0; n < iNumFaces; ++n) {
+        if (UINT_MAX == iBestFace) {
+            // no candidate around the cached vertices. Continue with the next face in input
+            // order, a full search for the best face would make the algorithm quadratic.
+            while (abEmitted[iNextFace]) {
+                ++iNextFace;
+            }
+            iBestFace = iNextFace;
+        }
+
+        // emit the face and put its vertices at the front of the cache
+        const aiFace &face = pMesh->mFaces[iBestFace];
+        abEmitted[iBestFace] = true;
+        piNewCache.clear();
+        for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+            const unsigned int dp = face.mIndices[i];
+            *piCSIter++ = dp;
+            if (piNewCache.end() == std::find(piNewCache.begin(), piNewCache.end(), dp)) {
+                --piNumTriPtr[dp];
+                piNewCache.push_back(dp);
+            }
+        }
+        const std::vector<unsigned int>::difference_type iFaceVerts = piNewCache.size();
+        for (std::vector<unsigned int>::const_iterator it = piCache.begin(); it != piCache.end(); ++it) {
+            if (piNewCache.begin() + iFaceVerts == std::find(piNewCache.begin(), piNewCache.begin() + iFaceVerts, *it)) {
+                piNewCache.push_back(*it);
+            }
+        }
+
+        // update the scores of all vertices which were or still are in the cache ...
+        for (unsigned int i = 0; i < piNewCache.size(); ++i) {
+            const unsigned int dp = piNewCache[i];
+            piCachePos[dp] = i < configCacheDepth ? static_cast<int>(i) : -1;
+            pfVertexScore[dp] = forsythVertexScore(piCachePos[dp], piNumTriPtr[dp], configCacheDepth);
+        }
+
+        // ... and of their remaining faces, the best of them is emitted next
+        iBestFace = UINT_MAX;
+        float fBestScore = -1.f;
+        for (unsigned int i = 0; i < piNewCache.size(); ++i) {
+            const unsigned int dp = piNewCache[i];
+            const unsigned int *piList = adj.GetAdjacentTriangles(dp);
+            for (unsigned int tri = 0; tri < piNumTriPtrNoModify[dp]; ++tri) {
+                const unsigned int fidx = piList[tri];
+                if (abEmitted[fidx]) {
+                    continue;
+                }
+                const aiFace &adjFace = pMesh->mFaces[fidx];
+                float fScore = 0.f;
+                for (unsigned int k = 0; k < adjFace.mNumIndices; ++k) {
+                    fScore += pfVertexScore[adjFace.mIndices[k]];
+                }
+                if (fScore > fBestScore) {
+                    fBestScore = fScore;
+                    iBestFace = fidx;
+                }
+            }
+        }
+
+        if (piNewCache.size() > configCacheDepth) {
+            piNewCache.resize(configCacheDepth);
+        }
+        piCache.swap(piNewCache);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+static void reorderArray(T *&pData, const std::vector<unsigned int> &piRemap) {
+    if (nullptr == pData) {
+        return;
+    }
+    T *pOut = new T[piRemap.size()];
+    for (unsigned int i = 0; i < piRemap.size(); ++i) {
+        pOut[piRemap[i]] = pData[i];
+    }
+    delete[] pData;
+    pData = pOut;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename T>
+static void reorderVertexData(T *pMesh, const std::vector<unsigned int> &piRemap) {
+    reorderArray(pMesh->mVertices, piRemap);
+    reorderArray(pMesh->mNormals, piRemap);
+    reorderArray(pMesh->mTangents, piRemap);
+    reorderArray(pMesh->mBitangents, piRemap);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        reorderArray(pMesh->mColors[i], piRemap);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        reorderArray(pMesh->mTextureCoords[i], piRemap);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Sorts the vertices by their first use in the index buffer, so fetching them walks linearly
+// through memory. Vertices which are not referenced at all are moved to the end.
+static void reorderVertices(aiMesh *pMesh) {
+    std::vector<unsigned int> piRemap(pMesh->mNumVertices, UINT_MAX);
+    unsigned int iNext = 0;
+    bool bIdentity = true;
+
+    aiFace *const pcEnd = pMesh->mFaces + pMesh->mNumFaces;
+    for (aiFace *pcFace = pMesh->mFaces; pcFace != pcEnd; ++pcFace) {
+        for (unsigned int qq = 0; qq < pcFace->mNumIndices; ++qq) {
+            unsigned int &iNew = piRemap[pcFace->mIndices[qq]];
+            if (UINT_MAX == iNew) {
+                bIdentity = bIdentity && iNext == pcFace->mIndices[qq];
+                iNew = iNext++;
+            }
+            pcFace->mIndices[qq] = iNew;
+        }
+    }
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        if (UINT_MAX == piRemap[i]) {
+            bIdentity = bIdentity && iNext == i;
+            piRemap[i] = iNext++;
+        }
+    }
+    if (bIdentity) {
+        return;
+    }
+
+    reorderVertexData(pMesh, piRemap);
+    for (unsigned int i = 0; i < pMesh->mNumAnimMeshes; ++i) {
+        if (pMesh->mAnimMeshes[i]->mNumVertices == pMesh->mNumVertices) {
+            reorderVertexData(pMesh->mAnimMeshes[i], piRemap);
+        }
+    }
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        aiBone *pcBone = pMesh->mBones[i];
+        for (unsigned int a = 0; a < pcBone->mNumWeights; ++a) {
+            pcBone->mWeights[a].mVertexId = piRemap[pcBone->mWeights[a].mVertexId];
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Improves the cache coherency of a specific mesh
+ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshNum) {
+    ai_assert(nullptr != pMesh);
+
+    // Check whether the input data is valid
+    // - there must be vertices and faces
+    // - all faces must be triangulated or we can't operate on them
+    if (!pMesh->HasFaces() || !pMesh->HasPositions())
+        return static_cast<ai_real>(0.f);
+
+    if (pMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE) {
+        ASSIMP_LOG_ERROR("This algorithm works on triangle meshes only");
+        return static_cast<ai_real>(0.f);
+    }
+
+    if (pMesh->mNumVertices <= mConfigCacheDepth) {
+        return static_cast<ai_real>(0.f);
+    }
+
+    // Input ACMR is for logging purposes only
+    const bool bLog = !DefaultLogger::isNullLogger();
+    ai_real fACMR = 3.f;
+    if (bLog) {
+        fACMR = (ai_real)countCacheMisses(pMesh, mConfigCacheDepth) / pMesh->mNumFaces;
+        if (3.0 == fACMR) {
+            // the JoinIdenticalVertices process has not been executed on this
+            // mesh, otherwise this value would normally be at least minimally
+            // smaller than 3.0 ...
+            ASSIMP_LOG_WARN("Mesh ", meshNum, ": Not suitable for vcache optimization");
+        }
+    }
+
+    // first we need to build a vertex-triangle adjacency list
+    VertexTriangleAdjacency adj(pMesh->mFaces, pMesh->mNumFaces, pMesh->mNumVertices, true);
+
+    // allocate an empty output index buffer. We store the output indices in one large array.
+    // Since the number of triangles won't change the input faces can be reused. This is how
+    // we save thousands of redundant mini allocations for aiFace::mIndices
+    std::vector<unsigned int> piIBOutput(pMesh->mNumFaces * 3);
+    if (AI_ICL_METHOD_FORSYTH == mConfigMethod) {
+        optimizeForsyth(pMesh, adj, mConfigCacheDepth, piIBOutput);
+    } else {
+        optimizeTipsify(pMesh, adj, mConfigCacheDepth, piIBOutput);
     }
 
     // sort the output index buffer back to the input array
-    piCSIter = piIBOutput.begin();
+    std::vector<unsigned int>::const_iterator piCSIter = piIBOutput.begin();
+    const aiFace *const pcEnd = pMesh->mFaces + pMesh->mNumFaces;
     for (aiFace *pcFace = pMesh->mFaces; pcFace != pcEnd; ++pcFace) {
         unsigned nind = pcFace->mNumIndices;
         unsigned *ind = pcFace->mIndices;
@@ -376,6 +561,25 @@ ai_real ImproveCacheLocalityProcess::ProcessMesh(aiMesh *pMesh, unsigned int mes
             ind[2] = *piCSIter++;
     }
 
+    // optionally make the vertex fetch follow the new index order
+    if (mConfigReorderVertices) {
+        reorderVertices(pMesh);
+    }
+
+    ai_real fACMR2 = 0.0f;
+    if (bLog) {
+        const unsigned int iCacheMisses = countCacheMisses(pMesh, mConfigCacheDepth);
+        fACMR2 = static_cast<ai_real>(iCacheMisses) / pMesh->mNumFaces;
+        const ai_real fATVR = static_cast<ai_real>(iCacheMisses) / pMesh->mNumVertices;
+        const ai_real averageACMR = ((fACMR - fACMR2) / fACMR) * 100.f;
+        // very intense verbose logging ... prepare for much text if there are many meshes
+        if (DefaultLogger::get()->getLogSeverity() == Logger::VERBOSE) {
+            ASSIMP_LOG_VERBOSE_DEBUG("Mesh ", meshNum, "| ACMR in: ", fACMR, " out: ", fACMR2, " | ATVR out: ", fATVR,
+                    " | average ACMR ", averageACMR);
+        }
+        fACMR2 *= pMesh->mNumFaces;
+    }
+
     return fACMR2;
 }
 
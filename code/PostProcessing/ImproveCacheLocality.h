@@ -56,11 +56,12 @@ namespace Assimp {
 // ---------------------------------------------------------------------------
 /** The ImproveCacheLocalityProcess reorders all faces for improved vertex
  *  cache locality. It tries to arrange all faces to fans and to render
- *  faces which share vertices directly one after the other.
+ *  faces which share vertices directly one after the other. Optionally
+ *  the vertices are sorted by their first use afterwards.
  *
  *  @note This step expects triagulated input data.
  */
-class ImproveCacheLocalityProcess : public BaseProcess {
+class ASSIMP_API ImproveCacheLocalityProcess : public BaseProcess {
 public:
     // -------------------------------------------------------------------
     /// The default class constructor / destructor.
@@ -91,6 +92,14 @@ private:
     //! Configuration parameter: specifies the size of the cache to
     //! optimize the vertex data for.
     unsigned int mConfigCacheDepth;
+
+    //! Configuration parameter: the optimizer to use,
+    //! one of the AI_ICL_METHOD_XXX values.
+    unsigned int mConfigMethod;
+
+    //! Configuration parameter: reorder the vertices to
+    //! match the optimized index buffer.
+    bool mConfigReorderVertices;
 };
 
 } // end of namespace Assimp
@@ -99,45 +99,43 @@ void JoinVerticesProcess::Execute( aiScene* pScene) {
 
 namespace {
 
+// ------------------------------------------------------------------------------------------------
+// Compares two vertices of a mesh, looking at the attributes present in the mesh only.
 bool areVerticesEqual(
-    const Vertex &lhs,
-    const Vertex &rhs,
+    const aiMesh *mesh,
+    unsigned int lhs,
+    unsigned int rhs,
     unsigned numUVChannels,
     unsigned numColorChannels) {
-    // A little helper to find locally close vertices faster.
-    // Try to reuse the lookup table from the last step.
     const static float epsilon = 1e-5f;
     // Squared because we check against squared length of the vector difference
     static const float squareEpsilon = epsilon * epsilon;
 
     // Square compare is useful for animeshes vertices compare
-    if ((lhs.position - rhs.position).SquareLength() > squareEpsilon) {
+    if ((mesh->mVertices[lhs] - mesh->mVertices[rhs]).SquareLength() > squareEpsilon) {
         return false;
     }
 
-    // We just test the other attributes even if they're not present in the mesh.
-    // In this case they're initialized to 0 so the comparison succeeds.
-    // By this method the non-present attributes are effectively ignored in the comparison.
-    if ((lhs.normal - rhs.normal).SquareLength() > squareEpsilon) {
+    if (mesh->mNormals && (mesh->mNormals[lhs] - mesh->mNormals[rhs]).SquareLength() > squareEpsilon) {
         return false;
     }
 
-    if ((lhs.tangent - rhs.tangent).SquareLength() > squareEpsilon) {
+    if (mesh->mTangents && (mesh->mTangents[lhs] - mesh->mTangents[rhs]).SquareLength() > squareEpsilon) {
         return false;
     }
 
-    if ((lhs.bitangent - rhs.bitangent).SquareLength() > squareEpsilon) {
+    if (mesh->mBitangents && (mesh->mBitangents[lhs] - mesh->mBitangents[rhs]).SquareLength() > squareEpsilon) {
         return false;
     }
 
     for (unsigned i = 0; i < numUVChannels; i++) {
-        if ((lhs.texcoords[i] - rhs.texcoords[i]).SquareLength() > squareEpsilon) {
+        if ((mesh->mTextureCoords[i][lhs] - mesh->mTextureCoords[i][rhs]).SquareLength() > squareEpsilon) {
             return false;
         }
     }
 
     for (unsigned i = 0; i < numColorChannels; i++) {
-        if (GetColorDifference(lhs.colors[i], rhs.colors[i]) > squareEpsilon) {
+        if (GetColorDifference(mesh->mColors[i][lhs], mesh->mColors[i][rhs]) > squareEpsilon) {
             return false;
         }
     }
@@ -145,6 +143,53 @@ bool areVerticesEqual(
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+// combine hashes
+inline void hash_combine(std::size_t &) {
+    // empty
+}
+
+template <typename T, typename... Rest>
+inline void hash_combine(std::size_t& seed, const T& v, Rest... rest) {
+    std::hash<T> hasher;
+    seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+    hash_combine(seed, rest...);
+}
+
+// ------------------------------------------------------------------------------------------------
+// The vertex lookup table is keyed by vertex index. Hashing and comparison read the vertex
+// attributes straight from the mesh, so no copy of the vertex data is kept in the table.
+struct VertexIndexHash {
+    explicit VertexIndexHash(const aiMesh *mesh) :
+            mMesh(mesh) {}
+
+    std::size_t operator()(unsigned int index) const noexcept {
+        const aiVector3D &position = mMesh->mVertices[index];
+        size_t seed = 0;
+        hash_combine(seed, position.x, position.y, position.z);
+        return seed;
+    }
+
+private:
+    const aiMesh *mMesh;
+};
+
+struct VertexIndexEqual {
+    explicit VertexIndexEqual(const aiMesh *mesh) :
+            mMesh(mesh),
+            mNumUVChannels(mesh->GetNumUVChannels()),
+            mNumColorChannels(mesh->GetNumColorChannels()) {}
+
+    bool operator()(unsigned int lhs, unsigned int rhs) const {
+        return areVerticesEqual(mMesh, lhs, rhs, mNumUVChannels, mNumColorChannels);
+    }
+
+private:
+    const aiMesh *mMesh;
+    unsigned mNumUVChannels;
+    unsigned mNumColorChannels;
+};
+
 template<class XMesh>
 void updateXMeshVertices(XMesh *pMesh, std::vector<int> &uniqueVertices) {
     // replace vertex data with the unique data sets
@@ -203,46 +248,10 @@ void updateXMeshVertices(XMesh *pMesh, std::vector<int> &uniqueVertices) {
 
 } // namespace
 
-// ------------------------------------------------------------------------------------------------
-// Unites identical vertices in the given mesh
-// combine hashes
-inline void hash_combine(std::size_t &) {
-    // empty
-}
-
-template <typename T, typename... Rest>
-inline void hash_combine(std::size_t& seed, const T& v, Rest... rest) {
-    std::hash<T> hasher;
-    seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
-    hash_combine(seed, rest...);
-}
-//template specialization for std::hash for Vertex
-template<>
-struct std::hash<Vertex> {
-    std::size_t operator()(Vertex const& v) const noexcept {
-        size_t seed = 0;
-        hash_combine(seed, v.position.x ,v.position.y,v.position.z);
-        return seed;
-    }
-};
-//template specialization for std::equal_to for Vertex
-template<>
-struct std::equal_to<Vertex> {
-    equal_to(unsigned numUVChannels, unsigned numColorChannels) :
-            mNumUVChannels(numUVChannels),
-            mNumColorChannels(numColorChannels) {}
-    bool operator()(const Vertex &lhs, const Vertex &rhs) const {
-        return areVerticesEqual(lhs, rhs, mNumUVChannels, mNumColorChannels);
-    }
-
-private:
-    unsigned mNumUVChannels;
-    unsigned mNumColorChannels;
-};
-
 static constexpr size_t JOINED_VERTICES_MARK = 0x80000000u;
 
-// now start the JoinVerticesProcess
+// ------------------------------------------------------------------------------------------------
+// Unites identical vertices in the given mesh
 int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     static_assert( AI_MAX_NUMBER_OF_COLOR_SETS    == 8, "AI_MAX_NUMBER_OF_COLOR_SETS    == 8");
 	static_assert( AI_MAX_NUMBER_OF_TEXTURECOORDS == 8, "AI_MAX_NUMBER_OF_TEXTURECOORDS == 8");
@@ -276,33 +285,6 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
     std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
-    // float posEpsilonSqr;
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
-
-    // Again, better waste some bytes than a realloc ...
-    std::vector<unsigned int> verticesFound;
-    verticesFound.reserve(10);
-
-    // Run an optimized code path if we don't have multiple UVs or vertex colors.
-    // This should yield false in more than 99% of all imports ...
     const bool hasAnimMeshes = pMesh->mNumAnimMeshes > 0;
 
     // We'll never have more vertices afterwards.
@@ -313,15 +295,10 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
             uniqueAnimatedVertices[animMeshIndex].reserve(pMesh->mNumVertices);
         }
     }
-    // a map that maps a vertex to its new index
-    const auto numBuckets = pMesh->mNumVertices;
-    const auto hasher = std::hash<Vertex>();
-    const auto comparator = std::equal_to<Vertex>(
-            pMesh->GetNumUVChannels(),
-            pMesh->GetNumColorChannels());
-    std::unordered_map<Vertex, int> vertex2Index(numBuckets, hasher, comparator);
+    // a map that maps the index of the first occurrence of a vertex to its new index,
     // we can not end up with more vertices than we started with
-    vertex2Index.reserve(pMesh->mNumVertices);
+    std::unordered_map<unsigned int, int, VertexIndexHash, VertexIndexEqual> vertex2Index(
+            pMesh->mNumVertices, VertexIndexHash(pMesh), VertexIndexEqual(pMesh));
     // Now check each vertex if it brings something new to the table
     int newIndex = 0;
     for( unsigned int a = 0; a < pMesh->mNumVertices; a++)  {
@@ -329,14 +306,9 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
         if (!usedVertexIndicesMask[a]) {
             continue;
         }
-        // collect the vertex data
-        Vertex v(pMesh,a);
-        // is the vertex already in the map?
-        auto it = vertex2Index.find(v);
-        // if the vertex is not in the map then it is a new vertex add it.
-        if (it == vertex2Index.end()) {
-            // this is a new vertex give it a new index
-            vertex2Index[v] = newIndex;
+        // is the vertex already in the map? if not then it is a new vertex, give it a new index
+        auto it = vertex2Index.emplace(a, newIndex);
+        if (it.second) {
             //keep track of its index and increment 1
             replaceIndex[a] = newIndex++;
             // add the vertex to the unique vertices
@@ -349,7 +321,7 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
         } else{
             // if the vertex is already there just find the replace index that is appropriate to it
 			// mark it with JOINED_VERTICES_MARK
-            replaceIndex[a] = it->second | JOINED_VERTICES_MARK;
+            replaceIndex[a] = it.first->second | JOINED_VERTICES_MARK;
         }
     }
 
@@ -37,13 +37,15 @@ THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------- */
 #include "LimitBoneWeightsProcess.h"
-#include <assimp/SmallVector.h>
 #include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace Assimp {
 
 // Make sure this value is set.
@@ -53,7 +55,7 @@ namespace Assimp {
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-LimitBoneWeightsProcess::LimitBoneWeightsProcess() : mMaxWeights(AI_LMW_MAX_WEIGHTS) {
+LimitBoneWeightsProcess::LimitBoneWeightsProcess() : mMaxWeights(AI_LMW_MAX_WEIGHTS), mRemoveEmptyBones(true) {
     // empty
 }
 
@@ -107,53 +109,79 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh) {
     if (!pMesh->HasBones())
         return;
 
-    // collect all bone weights per vertex
-    typedef SmallVector<Weight,8> VertexWeightArray;
-    typedef std::vector<VertexWeightArray> WeightsPerVertex;
-    WeightsPerVertex vertexWeights(pMesh->mNumVertices);
-    size_t maxVertexWeights = 0;
-
+    // count the bone weights per vertex first, so all weights fit
+    // into a single array with one range per vertex
+    std::vector<unsigned int> offsets(pMesh->mNumVertices + 1, 0);
     for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
         const aiBone* bone = pMesh->mBones[b];
         for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
-            const aiVertexWeight& vw = bone->mWeights[w];
-
-            if (vertexWeights.size() <= vw.mVertexId)
-                continue;
-
-            vertexWeights[vw.mVertexId].push_back(Weight(b, vw.mWeight));
-            maxVertexWeights = std::max(maxVertexWeights, vertexWeights[vw.mVertexId].size());
+            const unsigned int v = bone->mWeights[w].mVertexId;
+            if (v < pMesh->mNumVertices) {
+                ++offsets[v + 1];
+            }
         }
     }
 
+    unsigned int maxVertexWeights = 0;
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        maxVertexWeights = std::max(maxVertexWeights, offsets[v + 1]);
+        offsets[v + 1] += offsets[v];
+    }
+
     if (maxVertexWeights <= mMaxWeights)
         return;
 
+    // collect all bone weights per vertex
+    std::vector<Weight> vertexWeights(offsets[pMesh->mNumVertices]);
+    std::vector<unsigned int> counts(pMesh->mNumVertices, 0);
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b) {
+        const aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+            const aiVertexWeight& vw = bone->mWeights[w];
+            if (vw.mVertexId < pMesh->mNumVertices) {
+                vertexWeights[offsets[vw.mVertexId] + counts[vw.mVertexId]++] = Weight(b, vw.mWeight);
+            }
+        }
+    }
+
     unsigned int removed = 0, old_bones = pMesh->mNumBones;
 
     // now cut the weight count if it exceeds the maximum
-    for (WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit) {
-        if (vit->size() <= mMaxWeights)
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        unsigned int &count = counts[v];
+        if (count <= mMaxWeights)
             continue;
 
-        // more than the defined maximum -> first sort by weight in descending order. That's
-        // why we defined the < operator in such a weird way.
-        std::sort(vit->begin(), vit->end());
+        // more than the defined maximum -> move the largest weights to the front, in
+        // descending order. Only the kept part is sorted, equal weights keep their order.
+        Weight* first = vertexWeights.data() + offsets[v];
+        for (unsigned int a = 0; a < count; ++a) {
+            const Weight w = first[a];
+            unsigned int b = std::min(a, mMaxWeights);
+            if (b == mMaxWeights && (0 == b || !(w < first[b - 1])))
+                continue;
+
+            for (; b > 0 && w < first[b - 1]; --b) {
+                if (b < mMaxWeights) {
+                    first[b] = first[b - 1];
+                }
+            }
+            first[b] = w;
+        }
 
         // now kill everything beyond the maximum count
-        unsigned int m = static_cast<unsigned int>(vit->size());
-        vit->resize(mMaxWeights);
-        removed += static_cast<unsigned int>(m - vit->size());
+        removed += count - mMaxWeights;
+        count = mMaxWeights;
 
         // and renormalize the weights
         float sum = 0.0f;
-        for(const Weight* it = vit->begin(); it != vit->end(); ++it) {
-            sum += it->mWeight;
+        for (unsigned int a = 0; a < count; ++a) {
+            sum += first[a].mWeight;
         }
         if (0.0f != sum) {
             const float invSum = 1.0f / sum;
-            for(Weight* it = vit->begin(); it != vit->end(); ++it) {
-                it->mWeight *= invSum;
+            for (unsigned int a = 0; a < count; ++a) {
+                first[a].mWeight *= invSum;
             }
         }
     }
@@ -164,11 +192,11 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh) {
     }
 
     // rebuild the vertex weight array for all bones
-    for (unsigned int a = 0; a < vertexWeights.size(); ++a) {
-        const VertexWeightArray& vw = vertexWeights[a];
-        for (const Weight* it = vw.begin(); it != vw.end(); ++it) {
-            aiBone* bone = pMesh->mBones[it->mBone];
-            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(a, it->mWeight);
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v) {
+        const Weight* first = vertexWeights.data() + offsets[v];
+        for (unsigned int a = 0; a < counts[v]; ++a) {
+            aiBone* bone = pMesh->mBones[first[a].mBone];
+            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(v, first[a].mWeight);
         }
     }
 
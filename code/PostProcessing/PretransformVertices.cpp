@@ -48,6 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 #include <assimp/SceneCombiner.h>
 
+#include <algorithm>
+#include <map>
+
 using namespace Assimp;
 
 // some array offsets
@@ -56,34 +59,193 @@ using namespace Assimp;
 
 namespace {
 
-// Get a bitwise combination identifying the vertex format of a mesh
-static unsigned int GetMeshVFormat(aiMesh *pcMesh)  {
-	// the vertex format is stored in aiMesh::mBones for later retrieval.
-	// there isn't a good reason to compute it a few hundred times
-	// from scratch. The pointer is unused as animations are lost
-	// during PretransformVertices.
-	if (pcMesh->mBones)
-		return (unsigned int)(uint64_t)pcMesh->mBones;
+// A mesh referenced by a node, the list of all instances is built in a
+// single depth-first traversal of the node graph
+struct MeshInstance {
+	const aiNode *mNode;
+	unsigned int mMesh;
+};
+
+// The instances going to the output mesh for a material and vertex format
+struct OutputMesh {
+	unsigned int mNumVertices = 0;
+	unsigned int mNumFaces = 0;
+	std::vector<unsigned int> mInstances;
+};
+
+// Orders transformation matrices element by element
+struct MatrixLess {
+	bool operator()(const std::pair<unsigned int, aiMatrix4x4> &a, const std::pair<unsigned int, aiMatrix4x4> &b) const {
+		if (a.first != b.first) {
+			return a.first < b.first;
+		}
+		return std::lexicographical_compare(&a.second.a1, &a.second.a1 + 16, &b.second.a1, &b.second.a1 + 16);
+	}
+};
 
-	const unsigned int iRet = GetMeshVFormatUnique(pcMesh);
+// Collect all mesh instances, meshes of a node come before its children
+void CollectInstances(const aiNode *pcNode, std::vector<MeshInstance> &instances) {
+	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
+		instances.push_back({ pcNode, pcNode->mMeshes[i] });
+	}
+	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
+		CollectInstances(pcNode->mChildren[i], instances);
+	}
+}
 
-	// store the value for later use
-	pcMesh->mBones = (aiBone **)(uint64_t)iRet;
-	return iRet;
+// Transform positions. The matrix is copied first so the compiler knows the
+// output doesn't alias it and can keep it in registers.
+void TransformPositions(const aiMatrix4x4 &mat, const aiVector3D *in, aiVector3D *out, unsigned int num) {
+	const aiMatrix4x4 m = mat;
+	for (unsigned int n = 0; n < num; ++n) {
+		const aiVector3D v = in[n];
+		out[n].x = m.a1 * v.x + m.a2 * v.y + m.a3 * v.z + m.a4;
+		out[n].y = m.b1 * v.x + m.b2 * v.y + m.b3 * v.z + m.b4;
+		out[n].z = m.c1 * v.x + m.c2 * v.y + m.c3 * v.z + m.c4;
+	}
 }
 
-// Get a list of all vertex formats that occur for a given material index
-// The output list contains duplicate elements
-static void GetVFormatList(const aiScene *pcScene, unsigned int iMat, std::list<unsigned int> &aiOut)  {
-	for (unsigned int i = 0; i < pcScene->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[i];
-		if (iMat == pcMesh->mMaterialIndex) {
-			aiOut.push_back(GetMeshVFormat(pcMesh));
-		}
+// Transform and renormalize direction vectors
+void TransformDirections(const aiMatrix3x3 &mat, const aiVector3D *in, aiVector3D *out, unsigned int num) {
+	const aiMatrix3x3 m = mat;
+	for (unsigned int n = 0; n < num; ++n) {
+		out[n] = (m * in[n]).Normalize();
 	}
 }
 
+// Copy the vertex and face data of all instances to the output mesh
+void CollectData(const aiScene *pcScene, const std::vector<MeshInstance> &instances, const OutputMesh &output,
+		unsigned int iVFormat, aiMesh *pcMeshOut, std::vector<unsigned int> &num_refs) {
+	unsigned int aiCurrent[2] = { 0, 0 };
+	for (unsigned int instance : output.mInstances) {
+		const aiNode *pcNode = instances[instance].mNode;
+		const aiMesh *pcMesh = pcScene->mMeshes[instances[instance].mMesh];
+
+		// Decrement mesh reference counter
+		unsigned int &num_ref = num_refs[instances[instance].mMesh];
+		ai_assert(0 != num_ref);
+		--num_ref;
+		// Save the name of the last mesh
+		if (num_ref == 0) {
+			pcMeshOut->mName = pcMesh->mName;
+		}
+
+		// No need to multiply if there's no transformation
+		if (pcNode->mTransformation.IsIdentity()) {
+			// copy positions without modifying them
+			::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mVertices,
+					pcMesh->mNumVertices * sizeof(aiVector3D));
+
+			if (iVFormat & 0x2) {
+				// copy normals without modifying them
+				::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mNormals,
+						pcMesh->mNumVertices * sizeof(aiVector3D));
+			}
+			if (iVFormat & 0x4) {
+				// copy tangents without modifying them
+				::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mTangents,
+						pcMesh->mNumVertices * sizeof(aiVector3D));
+				// copy bitangents without modifying them
+				::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mBitangents,
+						pcMesh->mNumVertices * sizeof(aiVector3D));
+			}
+		} else {
+			// copy positions, transform them to worldspace
+			TransformPositions(pcNode->mTransformation, pcMesh->mVertices,
+					pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
+
+			if (iVFormat & 0x6) {
+				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
+				mWorldIT.Inverse().Transpose();
+
+				// TODO: implement Inverse() for aiMatrix3x3
+				const aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+
+				if (iVFormat & 0x2) {
+					// copy normals, transform them to worldspace
+					TransformDirections(m, pcMesh->mNormals,
+							pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
+				}
+				if (iVFormat & 0x4) {
+					// copy tangents and bitangents, transform them to worldspace
+					TransformDirections(m, pcMesh->mTangents,
+							pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
+					TransformDirections(m, pcMesh->mBitangents,
+							pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX], pcMesh->mNumVertices);
+				}
+			}
+		}
+		unsigned int p = 0;
+		while (iVFormat & (0x100 << p)) {
+			// copy texture coordinates
+			memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mTextureCoords[p],
+					pcMesh->mNumVertices * sizeof(aiVector3D));
+			++p;
+		}
+		p = 0;
+		while (iVFormat & (0x1000000 << p)) {
+			// copy vertex colors
+			memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mColors[p],
+					pcMesh->mNumVertices * sizeof(aiColor4D));
+			++p;
+		}
+		// now we need to copy all faces. since we will delete the source mesh afterwards,
+		// we don't need to reallocate the array of indices except if this mesh is
+		// referenced multiple times.
+		for (unsigned int planck = 0; planck < pcMesh->mNumFaces; ++planck) {
+			aiFace &f_src = pcMesh->mFaces[planck];
+			aiFace &f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE] + planck];
+
+			const unsigned int num_idx = f_src.mNumIndices;
+
+			f_dst.mNumIndices = num_idx;
+
+			unsigned int *pi;
+			if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
+				pi = f_dst.mIndices = f_src.mIndices;
+
+				// offset all vertex indices
+				for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
+					pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
+				}
+			} else {
+				pi = f_dst.mIndices = new unsigned int[num_idx];
+
+				// copy and offset all vertex indices
+				for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
+					pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
+				}
+			}
+
+			// Update the mPrimitiveTypes member of the mesh
+			switch (num_idx) {
+				case 0x1:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
+					break;
+				case 0x2:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
+					break;
+				case 0x3:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+					break;
+				default:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+					break;
+			};
+		}
+		aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
+		aiCurrent[AI_PTVS_FACE] += pcMesh->mNumFaces;
+	}
 }
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 PretransformVertices::PretransformVertices() :
@@ -123,161 +285,6 @@ unsigned int PretransformVertices::CountNodes(const aiNode *pcNode) const {
 	return iRet;
 }
 
-// ------------------------------------------------------------------------------------------------
-// Count the number of vertices in the whole scene and a given material index
-void PretransformVertices::CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, unsigned int *piFaces, unsigned int *piVertices) const {
-	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			*piVertices += pcMesh->mNumVertices;
-			*piFaces += pcMesh->mNumFaces;
-		}
-	}
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CountVerticesAndFaces(pcScene, pcNode->mChildren[i], iMat, iVFormat, piFaces, piVertices);
-	}
-}
-
-// ------------------------------------------------------------------------------------------------
-// Collect vertex/face data
-void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, aiMesh *pcMeshOut,
-		unsigned int aiCurrent[2], unsigned int *num_refs) const {
-	// No need to multiply if there's no transformation
-	const bool identity = pcNode->mTransformation.IsIdentity();
-	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			// Decrement mesh reference counter
-			unsigned int &num_ref = num_refs[pcNode->mMeshes[i]];
-			ai_assert(0 != num_ref);
-			--num_ref;
-			// Save the name of the last mesh
-			if (num_ref == 0) {
-				pcMeshOut->mName = pcMesh->mName;
-			}
-
-			if (identity) {
-				// copy positions without modifying them
-				::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mVertices,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-
-				if (iVFormat & 0x2) {
-					// copy normals without modifying them
-					::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mNormals,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-				if (iVFormat & 0x4) {
-					// copy tangents without modifying them
-					::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mTangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-					// copy bitangents without modifying them
-					::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mBitangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-			} else {
-				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX] + n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
-				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
-				mWorldIT.Inverse().Transpose();
-
-				// TODO: implement Inverse() for aiMatrix3x3
-				aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
-
-				if (iVFormat & 0x2) {
-					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX] + n] =
-								(m * pcMesh->mNormals[n]).Normalize();
-					}
-				}
-				if (iVFormat & 0x4) {
-					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mTangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mBitangents[n]).Normalize();
-					}
-				}
-			}
-			unsigned int p = 0;
-			while (iVFormat & (0x100 << p)) {
-				// copy texture coordinates
-				memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mTextureCoords[p],
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-				++p;
-			}
-			p = 0;
-			while (iVFormat & (0x1000000 << p)) {
-				// copy vertex colors
-				memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mColors[p],
-						pcMesh->mNumVertices * sizeof(aiColor4D));
-				++p;
-			}
-			// now we need to copy all faces. since we will delete the source mesh afterwards,
-			// we don't need to reallocate the array of indices except if this mesh is
-			// referenced multiple times.
-			for (unsigned int planck = 0; planck < pcMesh->mNumFaces; ++planck) {
-				aiFace &f_src = pcMesh->mFaces[planck];
-				aiFace &f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE] + planck];
-
-				const unsigned int num_idx = f_src.mNumIndices;
-
-				f_dst.mNumIndices = num_idx;
-
-				unsigned int *pi;
-				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
-					pi = f_dst.mIndices = f_src.mIndices;
-
-					// offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
-					}
-				} else {
-					pi = f_dst.mIndices = new unsigned int[num_idx];
-
-					// copy and offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
-					}
-				}
-
-				// Update the mPrimitiveTypes member of the mesh
-				switch (pcMesh->mFaces[planck].mNumIndices) {
-					case 0x1:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
-						break;
-					case 0x2:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
-						break;
-					case 0x3:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-						break;
-					default:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-						break;
-				};
-			}
-			aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
-			aiCurrent[AI_PTVS_FACE] += pcMesh->mNumFaces;
-		}
-	}
-
-	// append all children of us
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CollectData(pcScene, pcNode->mChildren[i], iMat,
-				iVFormat, pcMeshOut, aiCurrent, num_refs);
-	}
-}
-
 // ------------------------------------------------------------------------------------------------
 // Compute the absolute transformation matrices of each node
 void PretransformVertices::ComputeAbsoluteTransform(aiNode *pcNode) {
@@ -332,55 +339,55 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 
 // ------------------------------------------------------------------------------------------------
 // Simple routine to build meshes in worldspace, no further optimization
-void PretransformVertices::BuildWCSMeshes(std::vector<aiMesh *> &out, aiMesh **in,
-		unsigned int numIn, aiNode *node) const {
+void PretransformVertices::BuildWCSMeshes(std::vector<aiMesh *> &out, std::vector<const aiMatrix4x4 *> &transforms,
+		aiMesh **in, unsigned int numIn, aiNode *node) const {
 	// NOTE:
-	//  aiMesh::mNumBones store original source mesh, or UINT_MAX if not a copy
-	//  aiMesh::mBones store reference to abs. transform we multiplied with
-
-	// process meshes
-	for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-		aiMesh *mesh = in[node->mMeshes[i]];
-
-		// check whether we can operate on this mesh
-		if (!mesh->mBones || *reinterpret_cast<aiMatrix4x4 *>(mesh->mBones) == node->mTransformation) {
-			// yes, we can.
-			mesh->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
-			mesh->mNumBones = UINT_MAX;
-			continue;
-		} 
-
-		// try to find us in the list of newly created meshes
-		for (unsigned int n = 0; n < out.size(); ++n) {
-			aiMesh *ctz = out[n];
-			if (ctz->mNumBones == node->mMeshes[i] && *reinterpret_cast<aiMatrix4x4 *>(ctz->mBones) == node->mTransformation) {
+	//  transforms holds the abs. transform each input mesh and each copy
+	//  in out will be multiplied with, in that order. Copies are looked
+	//  up by their source mesh and transform.
+	std::map<std::pair<unsigned int, aiMatrix4x4>, unsigned int, MatrixLess> copies;
+
+	std::vector<aiNode *> stack(1, node);
+	while (!stack.empty()) {
+		node = stack.back();
+		stack.pop_back();
+
+		// process meshes
+		for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+			const unsigned int source = node->mMeshes[i];
+
+			// check whether we can operate on this mesh
+			if (!transforms[source] || *transforms[source] == node->mTransformation) {
+				// yes, we can.
+				transforms[source] = &node->mTransformation;
+				continue;
+			}
 
+			// try to find us in the list of newly created meshes
+			const auto key = std::make_pair(source, node->mTransformation);
+			const auto it = copies.find(key);
+			if (it != copies.end()) {
 				// ok, use this one. Update node mesh index
-				node->mMeshes[i] = numIn + n;
+				node->mMeshes[i] = it->second;
+				continue;
 			}
-		}
-		if (node->mMeshes[i] < numIn) {
+
 			// Worst case. Need to operate on a full copy of the mesh
 			ASSIMP_LOG_INFO("PretransformVertices: Copying mesh due to mismatching transforms");
 			aiMesh *ntz;
-
-			const unsigned int cacheNumBones = mesh->mNumBones; //
-			mesh->mNumBones = 0;
-			SceneCombiner::Copy(&ntz, mesh);
-			mesh->mNumBones = cacheNumBones;
-
-			ntz->mNumBones = node->mMeshes[i];
-			ntz->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
+			SceneCombiner::Copy(&ntz, in[source]);
 
 			out.push_back(ntz);
+			transforms.push_back(&node->mTransformation);
 
 			node->mMeshes[i] = static_cast<unsigned int>(numIn + out.size() - 1);
+			copies.emplace(key, node->mMeshes[i]);
 		}
-	}
 
-	// call children
-	for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-		BuildWCSMeshes(out, in, numIn, node->mChildren[i]);
+		// process children in order
+		for (unsigned int i = node->mNumChildren; i > 0; --i) {
+			stack.push_back(node->mChildren[i - 1]);
+		}
 	}
 }
 
@@ -395,18 +402,6 @@ void PretransformVertices::MakeIdentityTransform(aiNode *nd) const {
 	}
 }
 
-// ------------------------------------------------------------------------------------------------
-// Build reference counters for all meshes
-void PretransformVertices::BuildMeshRefCountArray(const aiNode *nd, unsigned int *refs) const {
-	for (unsigned int i = 0; i < nd->mNumMeshes; ++i)
-		refs[nd->mMeshes[i]]++;
-
-	// call children
-	for (unsigned int i = 0; i < nd->mNumChildren; ++i) {
-		BuildMeshRefCountArray(nd->mChildren[i], refs);
-	}
-}
-
 // ------------------------------------------------------------------------------------------------
 static void appendNewMeshesToScene(aiScene *pScene, std::vector<aiMesh*> &apcOutMeshes) {
 	ai_assert(pScene != nullptr);
@@ -445,9 +440,8 @@ void PretransformVertices::Execute(aiScene *pScene) {
 	// first compute absolute transformation matrices for all nodes
 	ComputeAbsoluteTransform(pScene->mRootNode);
 
-	// Delete aiMesh::mBones for all meshes. The bones are
-	// removed during this step and we need the pointer as
-	// temporary storage
+	// Delete aiMesh::mBones for all meshes, the bones are
+	// removed during this step
 	for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 		aiMesh *mesh = pScene->mMeshes[i];
 
@@ -455,7 +449,8 @@ void PretransformVertices::Execute(aiScene *pScene) {
 			delete mesh->mBones[a];
 
 		delete[] mesh->mBones;
-        mesh->mBones = nullptr;
+		mesh->mBones = nullptr;
+		mesh->mNumBones = 0;
 	}
 
 	// now build a list of output meshes
@@ -467,68 +462,79 @@ void PretransformVertices::Execute(aiScene *pScene) {
 	// is required.
 	if (mConfigKeepHierarchy) {
 
-		// Hack: store the matrix we're transforming a mesh with in aiMesh::mBones
-		BuildWCSMeshes(apcOutMeshes, pScene->mMeshes, pScene->mNumMeshes, pScene->mRootNode);
+		// the matrix we're transforming each mesh with, unreferenced meshes are left alone
+		std::vector<const aiMatrix4x4 *> transforms(pScene->mNumMeshes, nullptr);
+		BuildWCSMeshes(apcOutMeshes, transforms, pScene->mMeshes, pScene->mNumMeshes, pScene->mRootNode);
 
 		// ... if new meshes have been generated, append them to the end of the scene
 		appendNewMeshesToScene(pScene, apcOutMeshes);
 
 		// now iterate through all meshes and transform them to world-space
 		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-			ApplyTransform(pScene->mMeshes[i], *reinterpret_cast<aiMatrix4x4 *>(pScene->mMeshes[i]->mBones));
-
-			// prevent improper destruction
-            pScene->mMeshes[i]->mBones = nullptr;
-			pScene->mMeshes[i]->mNumBones = 0;
+			if (transforms[i]) {
+				ApplyTransform(pScene->mMeshes[i], *transforms[i]);
+			}
 		}
 	} else {
-		apcOutMeshes.reserve(static_cast<size_t>(pScene->mNumMaterials) << 1u);
-		std::list<unsigned int> aiVFormats;
+		// a single traversal of the node graph collects all mesh instances, which
+		// are then grouped by material and vertex format. The vertex format of
+		// each mesh is only computed once.
+		std::vector<MeshInstance> instances;
+		CollectInstances(pScene->mRootNode, instances);
+
+		std::vector<unsigned int> formats(pScene->mNumMeshes);
+		for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+			formats[i] = GetMeshVFormatUnique(pScene->mMeshes[i]);
+		}
 
 		std::vector<unsigned int> s(pScene->mNumMeshes, 0);
-		BuildMeshRefCountArray(pScene->mRootNode, &s[0]);
-
-		for (unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
-			// get the list of all vertex formats for this material
-			aiVFormats.clear();
-			GetVFormatList(pScene, i, aiVFormats);
-			aiVFormats.sort();
-			aiVFormats.unique();
-			for (std::list<unsigned int>::const_iterator j = aiVFormats.begin(); j != aiVFormats.end(); ++j) {
-				unsigned int numVertices = 0u;
-				unsigned int numFaces = 0u;
-				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &numFaces, &numVertices);
-				if (0 != numFaces && 0 != numVertices) {
-					apcOutMeshes.push_back(new aiMesh());
-					aiMesh *pcMesh = apcOutMeshes.back();
-					pcMesh->mNumFaces = numFaces;
-					pcMesh->mNumVertices = numVertices;
-					pcMesh->mFaces = new aiFace[numFaces];
-					pcMesh->mVertices = new aiVector3D[numVertices];
-					pcMesh->mMaterialIndex = i;
-					if ((*j) & 0x2) pcMesh->mNormals = new aiVector3D[numVertices];
-					if ((*j) & 0x4) {
-						pcMesh->mTangents = new aiVector3D[numVertices];
-						pcMesh->mBitangents = new aiVector3D[numVertices];
-					}
-					numFaces = 0;
-					while ((*j) & (0x100 << numFaces)) {
-						pcMesh->mTextureCoords[numFaces] = new aiVector3D[numVertices];
-						if ((*j) & (0x10000 << numFaces)) {
-							pcMesh->mNumUVComponents[numFaces] = 3;
-						} else {
-							pcMesh->mNumUVComponents[numFaces] = 2;
-						}
-						++numFaces;
-					}
-					numFaces = 0;
-					while ((*j) & (0x1000000 << numFaces))
-						pcMesh->mColors[numFaces++] = new aiColor4D[numVertices];
+		std::map<std::pair<unsigned int, unsigned int>, OutputMesh> outputs;
+		for (unsigned int i = 0; i < instances.size(); ++i) {
+			const aiMesh *mesh = pScene->mMeshes[instances[i].mMesh];
+			++s[instances[i].mMesh];
+			if (mesh->mMaterialIndex >= pScene->mNumMaterials) {
+				continue;
+			}
+			OutputMesh &output = outputs[std::make_pair(mesh->mMaterialIndex, formats[instances[i].mMesh])];
+			output.mNumVertices += mesh->mNumVertices;
+			output.mNumFaces += mesh->mNumFaces;
+			output.mInstances.push_back(i);
+		}
 
-					// fill the mesh ...
-					unsigned int aiTemp[2] = { 0, 0 };
-					CollectData(pScene, pScene->mRootNode, i, *j, pcMesh, aiTemp, &s[0]);
+		apcOutMeshes.reserve(outputs.size());
+		for (const auto &entry : outputs) {
+			const unsigned int iVFormat = entry.first.second;
+			unsigned int numVertices = entry.second.mNumVertices;
+			unsigned int numFaces = entry.second.mNumFaces;
+			if (0 != numFaces && 0 != numVertices) {
+				apcOutMeshes.push_back(new aiMesh());
+				aiMesh *pcMesh = apcOutMeshes.back();
+				pcMesh->mNumFaces = numFaces;
+				pcMesh->mNumVertices = numVertices;
+				pcMesh->mFaces = new aiFace[numFaces];
+				pcMesh->mVertices = new aiVector3D[numVertices];
+				pcMesh->mMaterialIndex = entry.first.first;
+				if (iVFormat & 0x2) pcMesh->mNormals = new aiVector3D[numVertices];
+				if (iVFormat & 0x4) {
+					pcMesh->mTangents = new aiVector3D[numVertices];
+					pcMesh->mBitangents = new aiVector3D[numVertices];
+				}
+				numFaces = 0;
+				while (iVFormat & (0x100 << numFaces)) {
+					pcMesh->mTextureCoords[numFaces] = new aiVector3D[numVertices];
+					if (iVFormat & (0x10000 << numFaces)) {
+						pcMesh->mNumUVComponents[numFaces] = 3;
+					} else {
+						pcMesh->mNumUVComponents[numFaces] = 2;
+					}
+					++numFaces;
 				}
+				numFaces = 0;
+				while (iVFormat & (0x1000000 << numFaces))
+					pcMesh->mColors[numFaces++] = new aiColor4D[numVertices];
+
+				// fill the mesh ...
+				CollectData(pScene, instances, entry.second, iVFormat, pcMesh, s);
 			}
 		}
 
@@ -540,8 +546,6 @@ void PretransformVertices::Execute(aiScene *pScene) {
 			// now delete all meshes in the scene and build a new mesh list
 			for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
 				aiMesh *mesh = pScene->mMeshes[i];
-				mesh->mNumBones = 0;
-                mesh->mBones = nullptr;
 
 				// we're reusing the face index arrays. avoid destruction
 				for (unsigned int a = 0; a < mesh->mNumFaces; ++a) {
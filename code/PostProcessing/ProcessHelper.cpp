@@ -45,10 +45,35 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ProcessHelper.h"
 
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 
 namespace Assimp {
 
+namespace {
+
+// -------------------------------------------------------------------------------
+// Integer coordinates of a cell of the grid used by HasUniquePositions
+struct GridCell {
+    int32_t x, y, z;
+};
+
+// -------------------------------------------------------------------------------
+// Cheap hash for grid cells, the final mix spreads neighbouring cells over the table
+uint64_t HashCell(const GridCell &c) {
+    uint64_t h = static_cast<uint32_t>(c.x) * 0x9E3779B97F4A7C15ull +
+                 static_cast<uint32_t>(c.y) * 0xC2B2AE3D27D4EB4Full +
+                 static_cast<uint32_t>(c.z) * 0x165667B19E3779F9ull;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace
+
 // -------------------------------------------------------------------------------
 void ConvertListToStrings(const std::string &in, std::list<std::string> &out) {
     const char *s = in.c_str();
@@ -162,6 +187,79 @@ ai_real ComputePositionEpsilon(const aiMesh *const *pMeshes, size_t num) {
     return (maxVec - minVec).Length() * epsilon;
 }
 
+// -------------------------------------------------------------------------------
+bool HasUniquePositions(const aiMesh *pMesh, ai_real epsilon) {
+    ai_assert(nullptr != pMesh);
+    if (pMesh->mNumVertices < 2) {
+        return true;
+    }
+
+    // The vertices are hashed into a grid of cells four epsilons wide. A vertex closer than
+    // epsilon to another one lies in the same cell or, along each axis, in the neighbour
+    // across the border it is close to, so at most eight cells need to be searched.
+    aiVector3D minVec, maxVec;
+    ArrayBounds(pMesh->mVertices, pMesh->mNumVertices, minVec, maxVec);
+    const double cellSize = 4.0 * epsilon;
+    const aiVector3D extent = maxVec - minVec;
+    if (!(epsilon > 0) || std::max(extent.x, std::max(extent.y, extent.z)) / cellSize > double(1 << 30)) {
+        return false;
+    }
+    const int32_t lastCell[3] = { static_cast<int32_t>(extent.x / cellSize),
+        static_cast<int32_t>(extent.y / cellSize), static_cast<int32_t>(extent.z / cellSize) };
+    const ai_real squareEpsilon = epsilon * epsilon;
+
+    // a flat open addressing table of vertex indices, much cheaper than a node based map for
+    // large meshes. Most neighbour cells are empty, a bit per hashed cell small enough to stay
+    // in the cache saves the table lookup for them.
+    size_t capacity = 16;
+    while (capacity < size_t(pMesh->mNumVertices) * 2) {
+        capacity <<= 1;
+    }
+    std::vector<unsigned int> table(capacity, UINT_MAX);
+    std::vector<bool> occupied(capacity * 4, false);
+    const uint64_t occupiedMask = capacity * 4 - 1;
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        const aiVector3D &pos = pMesh->mVertices[i];
+        int32_t coords[3], sides[3];
+        for (unsigned int k = 0; k < 3; ++k) {
+            const double f = (pos[k] - minVec[k]) / cellSize, cell = std::floor(f);
+            coords[k] = static_cast<int32_t>(cell);
+            // a quarter of the cell is one epsilon, plus some slack for rounding
+            sides[k] = f - cell < 0.26 ? -1 : (f - cell > 0.74 ? 1 : 0);
+            if (coords[k] + sides[k] < 0 || coords[k] + sides[k] > lastCell[k]) {
+                sides[k] = 0;
+            }
+        }
+
+        for (unsigned int n = 0; n < 8; ++n) {
+            if (((n & 1) && !sides[0]) || ((n & 2) && !sides[1]) || ((n & 4) && !sides[2])) {
+                continue;
+            }
+            const GridCell cell{ coords[0] + ((n & 1) ? sides[0] : 0),
+                coords[1] + ((n & 2) ? sides[1] : 0),
+                coords[2] + ((n & 4) ? sides[2] : 0) };
+            const uint64_t hash = HashCell(cell);
+            if (!occupied[(hash >> 32) & occupiedMask]) {
+                continue;
+            }
+            for (size_t slot = static_cast<size_t>(hash) & (capacity - 1); table[slot] != UINT_MAX; slot = (slot + 1) & (capacity - 1)) {
+                if ((pMesh->mVertices[table[slot]] - pos).SquareLength() < squareEpsilon) {
+                    return false;
+                }
+            }
+        }
+
+        const uint64_t hash = HashCell(GridCell{ coords[0], coords[1], coords[2] });
+        occupied[(hash >> 32) & occupiedMask] = true;
+        size_t slot = static_cast<size_t>(hash) & (capacity - 1);
+        while (table[slot] != UINT_MAX) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        table[slot] = i;
+    }
+    return true;
+}
+
 // -------------------------------------------------------------------------------
 unsigned int GetMeshVFormatUnique(const aiMesh *pcMesh) {
     ai_assert(nullptr != pcMesh);
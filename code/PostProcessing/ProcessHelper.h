@@ -308,6 +308,11 @@ ai_real ComputePositionEpsilon(const aiMesh *pMesh);
 // Compute a good epsilon value for position comparisons on a array of meshes
 ai_real ComputePositionEpsilon(const aiMesh *const *pMeshes, size_t num);
 
+// -------------------------------------------------------------------------------
+// Check whether no two vertices of a mesh are closer than epsilon to each other,
+// i.e. whether a SpatialSort with that epsilon would find each vertex on its own
+bool HasUniquePositions(const aiMesh *pMesh, ai_real epsilon);
+
 // -------------------------------------------------------------------------------
 // Compute an unique value for the vertex format of a mesh
 unsigned int GetMeshVFormatUnique(const aiMesh *pcMesh);
@@ -48,13 +48,18 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "Material/MaterialSystem.h"
 #include <assimp/Exceptional.h>
+#include <assimp/Hash.h>
 #include <stdio.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-RemoveRedundantMatsProcess::RemoveRedundantMatsProcess() : mConfigFixedMaterials() {}
+RemoveRedundantMatsProcess::RemoveRedundantMatsProcess() : mConfigFixedMaterials(), mConfigCompareTextures(false) {}
 
 // ------------------------------------------------------------------------------------------------
 // Returns whether the processing step is present in the given flag field.
@@ -67,6 +72,60 @@ bool RemoveRedundantMatsProcess::IsActive( unsigned int pFlags) const {
 void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp) {
     // Get value of AI_CONFIG_PP_RRM_EXCLUDE_LIST
     mConfigFixedMaterials = pImp->GetPropertyString(AI_CONFIG_PP_RRM_EXCLUDE_LIST,"");
+    // Get value of AI_CONFIG_PP_RRM_COMPARE_TEXTURES
+    mConfigCompareTextures = pImp->GetPropertyBool(AI_CONFIG_PP_RRM_COMPARE_TEXTURES,false);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hash the content of an embedded texture
+static uint32_t ComputeTextureHash(const aiTexture* tex) {
+    uint32_t hash = SuperFastHash((const char*)&tex->mWidth, sizeof(unsigned int));
+    hash = SuperFastHash((const char*)&tex->mHeight, sizeof(unsigned int), hash);
+    hash = SuperFastHash(tex->achFormatHint, HINTMAXTEXTURELEN, hash);
+
+    // compressed textures store their size in bytes in mWidth
+    const size_t size = tex->mHeight ? tex->mWidth * tex->mHeight * sizeof(aiTexel) : tex->mWidth;
+    return SuperFastHash((const char*)tex->pcData, static_cast<unsigned int>(size), hash);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute a hash of a material which doesn't depend on the order of its properties.
+// textureHashes holds a hash per embedded texture if they are compared by content.
+static uint32_t ComputeCanonicalMaterialHash(const aiScene* pScene, const aiMaterial* mat,
+        const std::vector<uint32_t>& textureHashes) {
+    std::vector<uint32_t> hashes;
+    hashes.reserve(mat->mNumProperties);
+    for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+        const aiMaterialProperty* prop = mat->mProperties[i];
+
+        // Exclude all properties whose first character is '?' from the hash
+        // See doc for aiMaterialProperty.
+        if (nullptr == prop || prop->mKey.data[0] == '?') {
+            continue;
+        }
+
+        uint32_t hash = SuperFastHash(prop->mKey.data, (unsigned int)prop->mKey.length);
+        hash = SuperFastHash((const char*)&prop->mSemantic, sizeof(unsigned int), hash);
+        hash = SuperFastHash((const char*)&prop->mIndex, sizeof(unsigned int), hash);
+
+        // references to embedded textures are replaced with the hash of the texture
+        int texture = -1;
+        if (!textureHashes.empty() && prop->mType == aiPTI_String && !::strcmp(prop->mKey.data, _AI_MATKEY_TEXTURE_BASE)) {
+            aiString path;
+            if (AI_SUCCESS == aiGetMaterialString(mat, prop->mKey.data, prop->mSemantic, prop->mIndex, &path)) {
+                texture = pScene->GetEmbeddedTextureAndIndex(path.C_Str()).second;
+            }
+        }
+        if (texture >= 0) {
+            hash = SuperFastHash((const char*)&textureHashes[texture], sizeof(uint32_t), hash);
+        } else {
+            hash = SuperFastHash(prop->mData, prop->mDataLength, hash);
+        }
+        hashes.push_back(hash);
+    }
+
+    std::sort(hashes.begin(), hashes.end());
+    return SuperFastHash((const char*)hashes.data(), static_cast<unsigned int>(hashes.size() * sizeof(uint32_t)), 1503);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -88,6 +147,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
 
             std::list<std::string> strings;
             ConvertListToStrings(mConfigFixedMaterials,strings);
+            const std::unordered_set<std::string> fixed(strings.begin(), strings.end());
 
             for (unsigned int i = 0; i < pScene->mNumMaterials;++i) {
                 aiMaterial* mat = pScene->mMaterials[i];
@@ -96,8 +156,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
                 mat->Get(AI_MATKEY_NAME,name);
 
                 if (name.length) {
-                    std::list<std::string>::const_iterator it = std::find(strings.begin(), strings.end(), name.data);
-                    if (it != strings.end()) {
+                    if (fixed.count(name.data)) {
 
                         // Our brilliant 'salt': A single material property with ~ as first
                         // character to mark it as internal and temporary.
@@ -119,11 +178,21 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
         }
         unsigned int iNewNum = 0;
 
-        // Iterate through all materials and calculate a hash for them
-        // store all hashes in a list and so a quick search whether
-        // we do already have a specific hash. This allows us to
-        // determine which materials are identical.
-        uint32_t *aiHashes = new uint32_t[ pScene->mNumMaterials ];;
+        // Hash the content of all embedded textures, if materials referencing
+        // textures with identical content are to be joined
+        std::vector<uint32_t> textureHashes;
+        if (mConfigCompareTextures) {
+            textureHashes.reserve(pScene->mNumTextures);
+            for (unsigned int i = 0; i < pScene->mNumTextures; ++i) {
+                textureHashes.push_back(ComputeTextureHash(pScene->mTextures[i]));
+            }
+        }
+
+        // Iterate through all materials and calculate a hash for them.
+        // The first material with a specific hash is kept, all later
+        // ones are identical and just reference its index.
+        std::unordered_map<uint32_t, unsigned int> hashToMaterial;
+        hashToMaterial.reserve(pScene->mNumMaterials);
         for (unsigned int i = 0; i < pScene->mNumMaterials;++i) {
             // No mesh is referencing this material, remove it.
             if (!abReferenced[i]) {
@@ -133,21 +202,17 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
                 continue;
             }
 
-            // Check all previously mapped materials for a matching hash.
+            // Check for a previously mapped material with a matching hash.
             // On a match we can delete this material and just make it ref to the same index.
-            uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-            for (unsigned int a = 0; a < i;++a) {
-                if (abReferenced[a] && me == aiHashes[a]) {
-                    ++redundantRemoved;
-                    me = 0;
-                    aiMappingTable[i] = aiMappingTable[a];
-                    delete pScene->mMaterials[i];
-                    pScene->mMaterials[i] = nullptr;
-                    break;
-                }
-            }
-            // This is a new material that is referenced, add to the map.
-            if (me) {
+            const uint32_t me = ComputeCanonicalMaterialHash(pScene, pScene->mMaterials[i], textureHashes);
+            const auto it = hashToMaterial.emplace(me, i);
+            if (!it.second) {
+                ++redundantRemoved;
+                aiMappingTable[i] = aiMappingTable[it.first->second];
+                delete pScene->mMaterials[i];
+                pScene->mMaterials[i] = nullptr;
+            } else {
+                // This is a new material that is referenced, add to the map.
                 aiMappingTable[i] = iNewNum++;
             }
         }
@@ -190,7 +255,6 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene) {
             pScene->mNumMaterials = iNewNum;
         }
         // delete temporary storage
-        delete[] aiHashes;
         delete[] aiMappingTable;
     }
     if (redundantRemoved == 0 && unreferencedRemoved == 0) {
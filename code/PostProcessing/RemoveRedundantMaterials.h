@@ -92,9 +92,20 @@ public:
         return mConfigFixedMaterials;
     }
 
+    // -------------------------------------------------------------------
+    /** @brief Enable comparing embedded textures by their content
+     *  @param compare See #AI_CONFIG_PP_RRM_COMPARE_TEXTURES
+     */
+    void SetCompareTextures(bool compare) {
+        mConfigCompareTextures = compare;
+    }
+
 private:
     //! Configuration option: list of all fixed materials
     std::string mConfigFixedMaterials;
+
+    //! Configuration option: compare embedded textures by content
+    bool mConfigCompareTextures;
 };
 
 } // end of namespace Assimp
@@ -46,6 +46,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+// ------------------------------------------------------------------------------------------------
+// Scale the translation part of a transformation matrix. Equals decomposing the matrix
+// and composing it again with a scaled translation, without the rounding errors.
+static void scaleTranslation( aiMatrix4x4 &mat, ai_real scale ) {
+    mat.a4 *= scale;
+    mat.b4 *= scale;
+    mat.c4 *= scale;
+}
+
 // ------------------------------------------------------------------------------------------------
 ScaleProcess::ScaleProcess() : BaseProcess(), mScale( AI_CONFIG_GLOBAL_SCALE_FACTOR_DEFAULT ) {
     // empty
@@ -122,29 +131,12 @@ void ScaleProcess::Execute( aiScene* pScene ) {
 
         // bone placement / scaling
         for( unsigned int boneID = 0; boneID < mesh->mNumBones; boneID++) {
-            // Reconstruct matrix by transform rather than by scale
-            // This prevent scale values being changed which can
-            // be meaningful in some cases
+            // Only the translation is scaled, this keeps the scale
+            // values in the matrix, which can be meaningful in some cases
             // like when you want the modeller to see 1:1 compatibility.
-            aiBone* bone = mesh->mBones[boneID];
-
-            aiVector3D pos, scale;
-            aiQuaternion rotation;
-
-            bone->mOffsetMatrix.Decompose( scale, rotation, pos);
-
-            aiMatrix4x4 translation;
-            aiMatrix4x4::Translation( pos * mScale, translation );
-
-            aiMatrix4x4 scaling;
-            aiMatrix4x4::Scaling( aiVector3D(scale), scaling );
-
-            const aiMatrix4x4 RotMatrix = aiMatrix4x4(rotation.GetMatrix());
-
-            bone->mOffsetMatrix = translation * RotMatrix * scaling;
+            scaleTranslation( mesh->mBones[boneID]->mOffsetMatrix, mScale );
         }
 
-
         // animation mesh processing
         // convert by position rather than scale.
         for( unsigned int animMeshID = 0; animMeshID < mesh->mNumAnimMeshes; animMeshID++) {
@@ -173,27 +165,11 @@ void ScaleProcess::traverseNodes( aiNode *node, unsigned int nested_node_id ) {
 // ------------------------------------------------------------------------------------------------
 void ScaleProcess::applyScaling( aiNode *currentNode ) {
     if ( nullptr != currentNode ) {
-        // Reconstruct matrix by transform rather than by scale
-        // This prevent scale values being changed which can
-        // be meaningful in some cases
-        // like when you want the modeller to
-        // see 1:1 compatibility.
-
-        aiVector3D pos, scale;
-        aiQuaternion rotation;
-        currentNode->mTransformation.Decompose( scale, rotation, pos);
-
-        aiMatrix4x4 translation;
-        aiMatrix4x4::Translation( pos * mScale, translation );
-
-        aiMatrix4x4 scaling;
-
-        // note: we do not use mScale here, this is on purpose.
-        aiMatrix4x4::Scaling( scale, scaling );
-
-        aiMatrix4x4 RotMatrix = aiMatrix4x4 (rotation.GetMatrix());
-
-        currentNode->mTransformation = translation * RotMatrix * scaling;
+        // Only the translation is scaled, the rotation and scale parts
+        // of the matrix are kept. This prevent scale values being changed
+        // which can be meaningful in some cases like when you want the
+        // modeller to see 1:1 compatibility.
+        scaleTranslation( currentNode->mTransformation, mScale );
     }
 }
 
@@ -48,6 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include <assimp/Exceptional.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
@@ -179,6 +182,19 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
             }
         }
 
+        // bucket the faces by primitive type, so each submesh only
+        // visits its own faces instead of walking the whole mesh
+        unsigned int aiFirstPerPType[4] = { 0, aiNumPerPType[0], 0, 0 };
+        aiFirstPerPType[2] = aiFirstPerPType[1] + aiNumPerPType[1];
+        aiFirstPerPType[3] = aiFirstPerPType[2] + aiNumPerPType[2];
+        std::vector<unsigned int> facesPerPType(mesh->mNumFaces);
+        {
+            unsigned int aiCursor[4] = { aiFirstPerPType[0], aiFirstPerPType[1], aiFirstPerPType[2], aiFirstPerPType[3] };
+            for (unsigned int m = 0; m < mesh->mNumFaces; ++m) {
+                facesPerPType[aiCursor[std::min(mesh->mFaces[m].mNumIndices, 4u) - 1]++] = m;
+            }
+        }
+
         VertexWeightTable *avw = ComputeVertexBoneWeightTable(mesh);
         for (unsigned int real = 0; real < 4; ++real, ++meshIdx) {
             if (!aiNumPerPType[real] || mConfigRemoveMeshes & (1u << real)) {
@@ -284,11 +300,8 @@ void SortByPTypeProcess::Execute(aiScene *pScene) {
 
             unsigned int outIdx = 0;
             unsigned int amIdx = 0; // AnimMesh index
-            for (unsigned int m = 0; m < mesh->mNumFaces; ++m) {
-                aiFace &in = mesh->mFaces[m];
-                if ((real == 3 && in.mNumIndices <= 3) || (real != 3 && in.mNumIndices != real + 1)) {
-                    continue;
-                }
+            for (unsigned int m = 0; m < aiNumPerPType[real]; ++m) {
+                aiFace &in = mesh->mFaces[facesPerPType[aiFirstPerPType[real] + m]];
 
                 outFaces->mNumIndices = in.mNumIndices;
                 outFaces->mIndices = in.mIndices;
@@ -47,9 +47,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
+#include <map>
 #include <set>
 
 using namespace Assimp;
@@ -128,7 +130,11 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene) {
     // recurse through all nodes and translate the node's mesh indices to fit the new mesh array
     UpdateNode( pScene->mRootNode);
 
-    ASSIMP_LOG_DEBUG( "SplitByBoneCountProcess end: split ", mSubMeshIndices.size(), " meshes into ", meshes.size(), " submeshes." );
+    unsigned int numSplitMeshes = 0;
+    for( const IndexArray& subMeshes : mSubMeshIndices ) {
+        numSplitMeshes += subMeshes.size() > 1 ? 1 : 0;
+    }
+    ASSIMP_LOG_INFO( "SplitByBoneCountProcess end: split ", numSplitMeshes, " meshes, ", meshes.size(), " meshes (draw calls) in total." );
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -139,78 +145,129 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         return;
     }
 
-    // necessary optimisation: build a list of all affecting bones for each vertex
-    // TODO: (thom) maybe add a custom allocator here to avoid allocating tens of thousands of small arrays
+    // necessary optimisation: build a list of all affecting bones for each vertex. The lists
+    // share a single array, vertexOffsets holds the start of each vertex' range in it.
     typedef std::pair<unsigned int, float> BoneWeight;
-    std::vector< std::vector<BoneWeight> > vertexBones( pMesh->mNumVertices);
+    IndexArray vertexOffsets( pMesh->mNumVertices + 1, 0);
     for( unsigned int a = 0; a < pMesh->mNumBones; ++a) {
         const aiBone* bone = pMesh->mBones[a];
         for( unsigned int b = 0; b < bone->mNumWeights; ++b) {
-            if (bone->mWeights[b].mWeight > 0.0f) {
-                int vertexId = bone->mWeights[b].mVertexId;
-                vertexBones[vertexId].emplace_back(a, bone->mWeights[b].mWeight);
-                if (vertexBones[vertexId].size() > mMaxBoneCount) {
-                    throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
-                }
+            if (bone->mWeights[b].mWeight > 0.0f && bone->mWeights[b].mVertexId < pMesh->mNumVertices) {
+                ++vertexOffsets[bone->mWeights[b].mVertexId + 1];
+            }
+        }
+    }
+    for( unsigned int a = 0; a < pMesh->mNumVertices; ++a) {
+        if (vertexOffsets[a + 1] > mMaxBoneCount) {
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
+        }
+        vertexOffsets[a + 1] += vertexOffsets[a];
+    }
+    std::vector<BoneWeight> vertexBones( vertexOffsets[pMesh->mNumVertices]);
+    IndexArray vertexCursor( vertexOffsets.begin(), vertexOffsets.end() - 1);
+    for( unsigned int a = 0; a < pMesh->mNumBones; ++a) {
+        const aiBone* bone = pMesh->mBones[a];
+        for( unsigned int b = 0; b < bone->mNumWeights; ++b) {
+            if (bone->mWeights[b].mWeight > 0.0f && bone->mWeights[b].mVertexId < pMesh->mNumVertices) {
+                vertexBones[vertexCursor[bone->mWeights[b].mVertexId]++] = BoneWeight(a, bone->mWeights[b].mWeight);
             }
         }
     }
 
-    unsigned int numFacesHandled = 0;
-    std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
-    while( numFacesHandled < pMesh->mNumFaces ) {
+    // group the faces by the set of bones they require. Faces in a group always go
+    // to the same submesh, so the partitioning below works on groups instead of faces.
+    std::map<IndexArray, unsigned int> clusterLookup;
+    std::vector<IndexArray> clusterBones, clusterFaces;
+    std::vector<IndexArray> boneClusters( pMesh->mNumBones);
+    IndexArray faceBones;
+    for( unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace& face = pMesh->mFaces[a];
+        faceBones.clear();
+        for( unsigned int b = 0; b < face.mNumIndices; ++b ) {
+            for( unsigned int c = vertexOffsets[face.mIndices[b]]; c < vertexOffsets[face.mIndices[b] + 1]; ++c) {
+                faceBones.push_back( vertexBones[c].first);
+            }
+        }
+        std::sort( faceBones.begin(), faceBones.end());
+        faceBones.erase( std::unique( faceBones.begin(), faceBones.end()), faceBones.end());
+        if( faceBones.size() > mMaxBoneCount ) {
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
+        }
+
+        const auto it = clusterLookup.emplace( faceBones, static_cast<unsigned int>(clusterBones.size()));
+        if( it.second ) {
+            for( unsigned int bone : faceBones ) {
+                boneClusters[bone].push_back( it.first->second);
+            }
+            clusterBones.push_back( faceBones);
+            clusterFaces.emplace_back();
+        }
+        clusterFaces[it.first->second].push_back( a);
+    }
+
+    const unsigned int numClusters = static_cast<unsigned int>(clusterBones.size());
+    unsigned int numClustersHandled = 0;
+    std::vector<bool> isClusterHandled( numClusters, false);
+    // per group: the number of bones it would add to the current submesh
+    IndexArray numNewBones( numClusters);
+    while( numClustersHandled < numClusters ) {
         // which bones are used in the current submesh
         unsigned int numBones = 0;
         std::vector<bool> isBoneUsed( pMesh->mNumBones, false);
         // indices of the faces which are going to go into this submesh
         IndexArray subMeshFaces;
-        subMeshFaces.reserve( pMesh->mNumFaces);
-        // accumulated vertex count of all the faces in this submesh
-        unsigned int numSubMeshVertices = 0;
-
-        // add faces to the new submesh as long as all bones affecting the faces' vertices fit in the limit
-        for( unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
-            // skip if the face is already stored in a submesh
-            if( isFaceHandled[a] ) {
-                continue;
+
+        // the remaining groups, ordered by the number of bones they would add. Groups
+        // are added as long as they fit, taking those which share the most bones with
+        // the submesh first. This keeps the number of submeshes low.
+        std::set<std::pair<unsigned int, unsigned int>> queue;
+        for( unsigned int a = 0; a < numClusters; ++a) {
+            if( !isClusterHandled[a] ) {
+                numNewBones[a] = static_cast<unsigned int>(clusterBones[a].size());
+                queue.emplace( numNewBones[a], a);
             }
-            // a small local set of new bones for the current face. State of all used bones for that face
-            // can only be updated AFTER the face is completely analysed. Thanks to imre for the fix.
-            std::set<unsigned int> newBonesAtCurrentFace;
+        }
 
-            const aiFace& face = pMesh->mFaces[a];
-            // check every vertex if its bones would still fit into the current submesh
-            for( unsigned int b = 0; b < face.mNumIndices; ++b ) {
-                const std::vector<BoneWeight>& vb = vertexBones[face.mIndices[b]];
-                for( unsigned int c = 0; c < vb.size(); ++c) {
-                    unsigned int boneIndex = vb[c].first;
-                    if( !isBoneUsed[boneIndex] ) {
-                        newBonesAtCurrentFace.insert(boneIndex);
+        while( !queue.empty() && numBones + queue.begin()->first <= mMaxBoneCount ) {
+            const unsigned int cluster = queue.begin()->second;
+            queue.erase( queue.begin());
+            isClusterHandled[cluster] = true;
+            ++numClustersHandled;
+            subMeshFaces.insert( subMeshFaces.end(), clusterFaces[cluster].begin(), clusterFaces[cluster].end());
+
+            // mark all new bones as necessary and update the groups sharing them
+            for( unsigned int bone : clusterBones[cluster] ) {
+                if( isBoneUsed[bone] ) {
+                    continue;
+                }
+                isBoneUsed[bone] = true;
+                ++numBones;
+                for( unsigned int other : boneClusters[bone] ) {
+                    if( !isClusterHandled[other] ) {
+                        queue.erase( std::make_pair( numNewBones[other], other));
+                        queue.emplace( --numNewBones[other], other);
                     }
                 }
             }
+        }
 
-            // leave out the face if the new bones required for this face don't fit the bone count limit anymore
-            if( numBones + newBonesAtCurrentFace.size() > mMaxBoneCount ) {
-                continue;
-            }
+        // keep the faces in their original order
+        std::sort( subMeshFaces.begin(), subMeshFaces.end());
 
-            // mark all new bones as necessary
-            for (std::set<unsigned int>::iterator it = newBonesAtCurrentFace.begin(); it != newBonesAtCurrentFace.end(); ++it) {
-                if (!isBoneUsed[*it]) {
-                    isBoneUsed[*it] = true;
-                    ++numBones;
+        // vertices shared by faces of this submesh are only copied once
+        IndexArray previousVertexIndices; // per new vertex: its index in the source mesh
+        IndexArray newVertexIndices( pMesh->mNumVertices, std::numeric_limits<unsigned int>::max());
+        for( unsigned int a : subMeshFaces ) {
+            const aiFace& face = pMesh->mFaces[a];
+            for( unsigned int b = 0; b < face.mNumIndices; ++b ) {
+                unsigned int& newIndex = newVertexIndices[face.mIndices[b]];
+                if( newIndex == std::numeric_limits<unsigned int>::max() ) {
+                    newIndex = static_cast<unsigned int>(previousVertexIndices.size());
+                    previousVertexIndices.push_back( face.mIndices[b]);
                 }
             }
-
-            // store the face index and the vertex count
-            subMeshFaces.push_back( a);
-            numSubMeshVertices += face.mNumIndices;
-
-            // remember that this face is handled
-            isFaceHandled[a] = true;
-            ++numFacesHandled;
         }
+        const unsigned int numSubMeshVertices = static_cast<unsigned int>(previousVertexIndices.size());
 
         // create a new mesh to hold this subset of the source mesh
         aiMesh* newMesh = new aiMesh;
@@ -244,47 +301,40 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
             }
         }
 
-        // and copy over the data, generating faces with linear indices along the way
+        // and copy over the data
+        for( unsigned int a = 0; a < numSubMeshVertices; ++a ) {
+            const unsigned int srcIndex = previousVertexIndices[a];
+            newMesh->mVertices[a] = pMesh->mVertices[srcIndex];
+            if( pMesh->HasNormals() ) {
+                newMesh->mNormals[a] = pMesh->mNormals[srcIndex];
+            }
+            if( pMesh->HasTangentsAndBitangents() ) {
+                newMesh->mTangents[a] = pMesh->mTangents[srcIndex];
+                newMesh->mBitangents[a] = pMesh->mBitangents[srcIndex];
+            }
+            for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c ) {
+                if( pMesh->HasTextureCoords( c) ) {
+                    newMesh->mTextureCoords[c][a] = pMesh->mTextureCoords[c][srcIndex];
+                }
+            }
+            for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c ) {
+                if( pMesh->HasVertexColors( c) ) {
+                    newMesh->mColors[c][a] = pMesh->mColors[c][srcIndex];
+                }
+            }
+        }
+
         newMesh->mFaces = new aiFace[subMeshFaces.size()];
-        unsigned int nvi = 0; // next vertex index
-        IndexArray previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
         for( unsigned int a = 0; a < subMeshFaces.size(); ++a ) {
             const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
             aiFace& dstFace = newMesh->mFaces[a];
             dstFace.mNumIndices = srcFace.mNumIndices;
             dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
-
-            // accumulate linearly all the vertices of the source face
             for( unsigned int b = 0; b < dstFace.mNumIndices; ++b ) {
-                unsigned int srcIndex = srcFace.mIndices[b];
-                dstFace.mIndices[b] = nvi;
-                previousVertexIndices[nvi] = srcIndex;
-
-                newMesh->mVertices[nvi] = pMesh->mVertices[srcIndex];
-                if( pMesh->HasNormals() ) {
-                    newMesh->mNormals[nvi] = pMesh->mNormals[srcIndex];
-                }
-                if( pMesh->HasTangentsAndBitangents() ) {
-                    newMesh->mTangents[nvi] = pMesh->mTangents[srcIndex];
-                    newMesh->mBitangents[nvi] = pMesh->mBitangents[srcIndex];
-                }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c ) {
-                    if( pMesh->HasTextureCoords( c) ) {
-                        newMesh->mTextureCoords[c][nvi] = pMesh->mTextureCoords[c][srcIndex];
-                    }
-                }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c ) {
-                    if( pMesh->HasVertexColors( c) ) {
-                        newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
-                    }
-                }
-
-                nvi++;
+                dstFace.mIndices[b] = newVertexIndices[srcFace.mIndices[b]];
             }
         }
 
-        ai_assert( nvi == numSubMeshVertices );
-
         // Create the bones for the new submesh: first create the bone array
         newMesh->mNumBones = 0;
         newMesh->mBones = new aiBone*[numBones];
@@ -310,10 +360,9 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         // iterate over all new vertices and count which bones affected its old vertex in the source mesh
         for( unsigned int a = 0; a < numSubMeshVertices; ++a ) {
             unsigned int oldIndex = previousVertexIndices[a];
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
 
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b ) {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
+            for( unsigned int b = vertexOffsets[oldIndex]; b < vertexOffsets[oldIndex + 1]; ++b ) {
+                unsigned int newBoneIndex = mappedBoneIndex[ vertexBones[b].first ];
                 if( newBoneIndex != std::numeric_limits<unsigned int>::max() ) {
                     newMesh->mBones[newBoneIndex]->mNumWeights++;
                 }
@@ -332,18 +381,16 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         for( unsigned int a = 0; a < numSubMeshVertices; ++a) {
             // find the source vertex for it in the source mesh
             unsigned int previousIndex = previousVertexIndices[a];
-            // these bones were affecting it
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[previousIndex];
             // all of the bones affecting it should be present in the new submesh, or else
             // the face it comprises shouldn't be present
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b) {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
+            for( unsigned int b = vertexOffsets[previousIndex]; b < vertexOffsets[previousIndex + 1]; ++b) {
+                unsigned int newBoneIndex = mappedBoneIndex[ vertexBones[b].first ];
                 ai_assert( newBoneIndex != std::numeric_limits<unsigned int>::max() );
                 aiVertexWeight* dstWeight = newMesh->mBones[newBoneIndex]->mWeights + newMesh->mBones[newBoneIndex]->mNumWeights;
                 newMesh->mBones[newBoneIndex]->mNumWeights++;
 
                 dstWeight->mVertexId = a;
-                dstWeight->mWeight = bonesOnThisVertex[b].second;
+                dstWeight->mWeight = vertexBones[b].second;
             }
         }
 
@@ -394,7 +441,7 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 // Recursively updates the node's mesh list to account for the changed mesh list
 void SplitByBoneCountProcess::UpdateNode( aiNode* pNode) const {
     // rebuild the node's mesh index list
-    if( pNode->mNumMeshes == 0 ) {
+    if( pNode->mNumMeshes > 0 ) {
         IndexArray newMeshList;
         for( unsigned int a = 0; a < pNode->mNumMeshes; ++a) {
             unsigned int srcIndex = pNode->mMeshes[a];
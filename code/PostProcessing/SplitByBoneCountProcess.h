@@ -56,9 +56,10 @@ namespace Assimp {
  * so that each submesh has a certain max bone count.
  *
  * Applied BEFORE the JoinVertices-Step occurs.
- * Returns NON-UNIQUE vertices, splits by bone count.
+ * Faces requiring the same set of bones always end up in the same submesh,
+ * vertices shared by faces of one submesh stay shared.
 */
-class SplitByBoneCountProcess : public BaseProcess {
+class ASSIMP_API SplitByBoneCountProcess : public BaseProcess {
 public:
     // -------------------------------------------------------------------
     /// The default class constructor / destructor.
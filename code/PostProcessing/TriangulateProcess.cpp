@@ -63,6 +63,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/ProcessHelper.h"
 #include "Common/PolyTools.h"
 
+#include <algorithm>
 #include <memory>
 #include <cstdint>
 
@@ -154,6 +155,262 @@ namespace {
         unsigned int mLastNGONFirstIndex;
     };
 
+    /// Polygons with more vertices than this use the z-order index to find points inside ears.
+    constexpr unsigned int ZOrderThreshold = 80;
+
+    /**
+     * @brief Ear clipper for simple polygons projected into 2D (ccw winding).
+     *
+     * The outline is kept as a doubly linked list so clipped vertices never have to be
+     * skipped again. Large polygons are additionally linked along a z-order curve, which
+     * limits the point-in-ear test to the vertices near the ear's bounding box.
+     * The node storage is reused for all polygons passed to the same instance.
+     */
+    class EarClipper {
+    public:
+        /**
+         * @brief Triangulate a polygon.
+         *
+         * @param verts Projected polygon vertices.
+         * @param num Number of vertices, at least 3.
+         * @param out Receives the triangles as indices into verts, advanced past the last one.
+         * @return false if no ear could be found before the polygon was completely clipped.
+         */
+        bool Triangulate(const aiVector2D *verts, unsigned int num, aiFace *&out) {
+            mVerts = verts;
+            mNodes.resize(num);
+            for (unsigned int i = 0; i < num; ++i) {
+                EarNode &node = mNodes[i];
+                node.mIndex = i;
+                node.mZ = 0;
+                node.mPrev = &mNodes[i ? i - 1 : num - 1];
+                node.mNext = &mNodes[i + 1 < num ? i + 1 : 0];
+                node.mPrevZ = node.mNextZ = nullptr;
+            }
+            mHashed = num > ZOrderThreshold;
+            if (mHashed) {
+                BuildZOrder(num);
+            }
+
+            EarNode *ear = &mNodes[0];
+            unsigned int remaining = num, misses = 0;
+            bool filtered = false;
+            while (remaining > 3) {
+                if (mHashed ? IsEarHashed(ear) : IsEar(ear)) {
+                    Emit(out, ear);
+                    EarNode *next = ear->mNext;
+                    Remove(ear);
+                    --remaining;
+                    misses = 0;
+                    ear = next;
+                    continue;
+                }
+
+                ear = ear->mNext;
+                if (++misses < remaining) {
+                    continue;
+                }
+
+                // Due to the 'two ear theorem', every simple polygon with more than three points must
+                // have 2 'ears'. Duplicated or collinear points can hide them, so drop those once
+                // and retry before giving up.
+                if (filtered) {
+                    return false;
+                }
+                filtered = true;
+                misses = 0;
+                ear = FilterPoints(ear, remaining);
+            }
+
+            // We have three indices forming the last 'ear' remaining.
+            Emit(out, ear);
+            return true;
+        }
+
+    private:
+        struct EarNode {
+            unsigned int mIndex;
+            uint32_t mZ;
+            EarNode *mPrev, *mNext;
+            EarNode *mPrevZ, *mNextZ;
+        };
+
+        const aiVector2D &Pos(const EarNode *node) const {
+            return mVerts[node->mIndex];
+        }
+
+        static void Emit(aiFace *&out, const EarNode *ear) {
+            aiFace &nface = *out++;
+            nface.mNumIndices = 3;
+            if (!nface.mIndices) {
+                nface.mIndices = new unsigned int[3];
+            }
+            nface.mIndices[0] = ear->mPrev->mIndex;
+            nface.mIndices[1] = ear->mIndex;
+            nface.mIndices[2] = ear->mNext->mIndex;
+        }
+
+        static void Remove(EarNode *node) {
+            node->mNext->mPrev = node->mPrev;
+            node->mPrev->mNext = node->mNext;
+            if (node->mPrevZ) {
+                node->mPrevZ->mNextZ = node->mNextZ;
+            }
+            if (node->mNextZ) {
+                node->mNextZ->mPrevZ = node->mPrevZ;
+            }
+        }
+
+        uint32_t ZOrder(float x, float y) const {
+            // interleave the bits of both 16 bit grid coordinates
+            uint32_t ix = static_cast<uint32_t>((x - mMin.x) * mInvSize);
+            uint32_t iy = static_cast<uint32_t>((y - mMin.y) * mInvSize);
+
+            ix = (ix | (ix << 8)) & 0x00FF00FF;
+            ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+            ix = (ix | (ix << 2)) & 0x33333333;
+            ix = (ix | (ix << 1)) & 0x55555555;
+
+            iy = (iy | (iy << 8)) & 0x00FF00FF;
+            iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+            iy = (iy | (iy << 2)) & 0x33333333;
+            iy = (iy | (iy << 1)) & 0x55555555;
+
+            return ix | (iy << 1);
+        }
+
+        void BuildZOrder(unsigned int num) {
+            aiVector2D max = mMin = mVerts[0];
+            for (unsigned int i = 1; i < num; ++i) {
+                mMin.x = std::min(mMin.x, mVerts[i].x);
+                mMin.y = std::min(mMin.y, mVerts[i].y);
+                max.x = std::max(max.x, mVerts[i].x);
+                max.y = std::max(max.y, mVerts[i].y);
+            }
+            const float size = std::max(max.x - mMin.x, max.y - mMin.y);
+            mInvSize = size > 0.f ? 32767.f / size : 0.f;
+
+            mSorted.resize(num);
+            for (unsigned int i = 0; i < num; ++i) {
+                mNodes[i].mZ = ZOrder(mVerts[i].x, mVerts[i].y);
+                mSorted[i] = &mNodes[i];
+            }
+            std::sort(mSorted.begin(), mSorted.end(), [](const EarNode *a, const EarNode *b) {
+                return a->mZ < b->mZ;
+            });
+            for (unsigned int i = 1; i < num; ++i) {
+                mSorted[i - 1]->mNextZ = mSorted[i];
+                mSorted[i]->mPrevZ = mSorted[i - 1];
+            }
+        }
+
+        // Checks the corner itself: it must be convex and not degenerate.
+        bool IsConvexCorner(const EarNode *ear) const {
+            const aiVector2D &pnt0 = Pos(ear->mPrev), &pnt1 = Pos(ear), &pnt2 = Pos(ear->mNext);
+
+            // Must be a convex point. Assuming ccw winding, it must be on the right of the line between p-1 and p+1.
+            if (OnLeftSideOfLine2D(pnt0, pnt2, pnt1) == 1) {
+                return false;
+            }
+
+            // Skip when three point is in a line
+            aiVector2D left = pnt0 - pnt1;
+            aiVector2D right = pnt2 - pnt1;
+
+            left.Normalize();
+            right.Normalize();
+            const auto mul = left * right;
+
+            // if the angle is 0 or 180
+            return std::abs(mul - 1.f) >= ai_epsilon && std::abs(mul + 1.f) >= ai_epsilon;
+        }
+
+        // Checks whether the given vertex prevents the corner from being clipped.
+        bool IsInsideEar(const EarNode *ear, const EarNode *node) const {
+            if (node == ear || node == ear->mPrev || node == ear->mNext) {
+                return false;
+            }
+
+            // We need to compare the actual values because it's possible that multiple indexes in
+            // the polygon are referring to the same position. concave_polygon.obj is a sample
+            const aiVector2D &pnt0 = Pos(ear->mPrev), &pnt1 = Pos(ear), &pnt2 = Pos(ear->mNext);
+            const aiVector2D &vtmp = Pos(node);
+            if (vtmp == pnt0 || vtmp == pnt1 || vtmp == pnt2) {
+                return false;
+            }
+
+            // If any vertex lies inside an ear, a reflex one does as well, so convex ones can be skipped.
+            if (OnLeftSideOfLine2D(Pos(node->mPrev), Pos(node->mNext), vtmp) == -1) {
+                return false;
+            }
+            return PointInTriangle2D(pnt0, pnt1, pnt2, vtmp);
+        }
+
+        bool IsEar(const EarNode *ear) const {
+            if (!IsConvexCorner(ear)) {
+                return false;
+            }
+
+            // and no other point may be contained in this triangle
+            for (const EarNode *node = ear->mNext->mNext; node != ear->mPrev; node = node->mNext) {
+                if (IsInsideEar(ear, node)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool IsEarHashed(const EarNode *ear) const {
+            if (!IsConvexCorner(ear)) {
+                return false;
+            }
+
+            // only vertices within the z-order range of the ear's bounding box can be inside it
+            const aiVector2D &pnt0 = Pos(ear->mPrev), &pnt1 = Pos(ear), &pnt2 = Pos(ear->mNext);
+            const uint32_t minZ = ZOrder(std::min(pnt0.x, std::min(pnt1.x, pnt2.x)), std::min(pnt0.y, std::min(pnt1.y, pnt2.y)));
+            const uint32_t maxZ = ZOrder(std::max(pnt0.x, std::max(pnt1.x, pnt2.x)), std::max(pnt0.y, std::max(pnt1.y, pnt2.y)));
+
+            for (const EarNode *node = ear->mPrevZ; node && node->mZ >= minZ; node = node->mPrevZ) {
+                if (IsInsideEar(ear, node)) {
+                    return false;
+                }
+            }
+            for (const EarNode *node = ear->mNextZ; node && node->mZ <= maxZ; node = node->mNextZ) {
+                if (IsInsideEar(ear, node)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Removes duplicated and collinear points, returns a node still part of the outline.
+        EarNode *FilterPoints(EarNode *start, unsigned int &remaining) const {
+            EarNode *node = start;
+            bool again;
+            do {
+                again = false;
+                if (remaining > 3 && (Pos(node) == Pos(node->mNext) ||
+                        OnLeftSideOfLine2D(Pos(node->mPrev), Pos(node->mNext), Pos(node)) == 0)) {
+                    EarNode *prev = node->mPrev;
+                    Remove(node);
+                    --remaining;
+                    node = start = prev;
+                    again = true;
+                } else {
+                    node = node->mNext;
+                }
+            } while (again || node != start);
+            return start;
+        }
+
+        std::vector<EarNode> mNodes;
+        std::vector<EarNode *> mSorted;
+        const aiVector2D *mVerts = nullptr;
+        aiVector2D mMin;
+        float mInvSize = 0.f;
+        bool mHashed = false;
+    };
+
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -262,13 +519,12 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
 
     const aiVector3D* verts = pMesh->mVertices;
 
-    // use std::unique_ptr to avoid slow std::vector<bool> specialiations
-    std::unique_ptr<bool[]> done(new bool[max_out]);
+    EarClipper earClipper;
     for( unsigned int a = 0; a < pMesh->mNumFaces; a++) {
         aiFace& face = pMesh->mFaces[a];
 
         unsigned int* idx = face.mIndices;
-        int num = (int)face.mNumIndices, ear = 0, tmp, prev = num-1, next = 0, max = num;
+        int tmp, max = (int)face.mNumIndices;
 
         // Apply vertex colors to represent the face winding?
 #ifdef AI_BUILD_TRIANGULATE_COLOR_FACE_WINDING
@@ -399,7 +655,6 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
             for (tmp =0; tmp < max; ++tmp) {
                 temp_verts[tmp].x = verts[idx[tmp]][ac];
                 temp_verts[tmp].y = verts[idx[tmp]][bc];
-                done[tmp] = false;
             }
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
@@ -430,118 +685,13 @@ bool TriangulateProcess::TriangulateMesh( aiMesh* pMesh) {
             fprintf(fout,"\ntriangulation sequence: ");
 #endif
 
-            //
-            // FIXME: currently this is the slow O(kn) variant with a worst case
-            // complexity of O(n^2) (I think). Can be done in O(n).
-            while (num > 3) {
-
-                // Find the next ear of the polygon
-                int num_found = 0;
-                for (ear = next;;prev = ear,ear = next) {
-
-                    // break after we looped two times without a positive match
-                    for (next=ear+1;done[(next>=max?next=0:next)];++next);
-                    if (next < ear) {
-                        if (++num_found == 2) {
-                            break;
-                        }
-                    }
-                    const aiVector2D* pnt1 = &temp_verts[ear],
-                        *pnt0 = &temp_verts[prev],
-                        *pnt2 = &temp_verts[next];
-
-                    // Must be a convex point. Assuming ccw winding, it must be on the right of the line between p-1 and p+1.
-                    if (OnLeftSideOfLine2D(*pnt0,*pnt2,*pnt1) == 1) {
-                        continue;
-                    }
-
-                    // Skip when three point is in a line
-                    aiVector2D left = *pnt0 - *pnt1;
-                    aiVector2D right = *pnt2 - *pnt1;
-
-                    left.Normalize();
-                    right.Normalize();
-                    auto mul = left * right;
-
-                    // if the angle is 0 or 180
-                    if (std::abs(mul - 1.f) < ai_epsilon || std::abs(mul + 1.f) < ai_epsilon) {
-                        // skip this ear
-                        ASSIMP_LOG_WARN("Skip a ear, due to its angle is near 0 or 180.");
-                        continue;
-                    }
-
-                    // and no other point may be contained in this triangle
-                    for ( tmp = 0; tmp < max; ++tmp) {
-
-                        // We need to compare the actual values because it's possible that multiple indexes in
-                        // the polygon are referring to the same position. concave_polygon.obj is a sample
-                        //
-                        // FIXME: Use 'epsiloned' comparisons instead? Due to numeric inaccuracies in
-                        // PointInTriangle() I'm guessing that it's actually possible to construct
-                        // input data that would cause us to end up with no ears. The problem is,
-                        // which epsilon? If we chose a too large value, we'd get wrong results
-                        const aiVector2D& vtmp = temp_verts[tmp];
-                        if ( vtmp != *pnt1 && vtmp != *pnt2 && vtmp != *pnt0 && PointInTriangle2D(*pnt0,*pnt1,*pnt2,vtmp)) {
-                            break;
-                        }
-                    }
-                    if (tmp != max) {
-                        continue;
-                    }
-
-                    // this vertex is an ear
-                    break;
-                }
-                if (num_found == 2) {
-
-                    // Due to the 'two ear theorem', every simple polygon with more than three points must
-                    // have 2 'ears'. Here's definitely something wrong ... but we don't give up yet.
-                    //
-
-                    // Instead we're continuing with the standard tri-fanning algorithm which we'd
-                    // use if we had only convex polygons. That's life.
-                    ASSIMP_LOG_ERROR("Failed to triangulate polygon (no ear found). Probably not a simple polygon?");
+            if (!earClipper.Triangulate(&temp_verts.front(), static_cast<unsigned int>(max), curOut)) {
+                // Here's definitely something wrong ... the polygon is kept as far as it was clipped.
+                ASSIMP_LOG_ERROR("Failed to triangulate polygon (no ear found). Probably not a simple polygon?");
 
 #ifdef AI_BUILD_TRIANGULATE_DEBUG_POLYS
-                    fprintf(fout,"critical error here, no ear found! ");
+                fprintf(fout,"critical error here, no ear found! ");
 #endif
-                    num = 0;
-                    break;
-                }
-
-                aiFace& nface = *curOut++;
-                nface.mNumIndices = 3;
-
-                if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
-                }
-
-                // setup indices for the new triangle ...
-                nface.mIndices[0] = prev;
-                nface.mIndices[1] = ear;
-                nface.mIndices[2] = next;
-
-                // exclude the ear from most further processing
-                done[ear] = true;
-                --num;
-            }
-            if (num > 0) {
-                // We have three indices forming the last 'ear' remaining. Collect them.
-                aiFace& nface = *curOut++;
-                nface.mNumIndices = 3;
-                if (!nface.mIndices) {
-                    nface.mIndices = new unsigned int[3];
-                }
-
-                for (tmp = 0; done[tmp]; ++tmp);
-                nface.mIndices[0] = tmp;
-
-                for (++tmp; done[tmp]; ++tmp);
-                nface.mIndices[1] = tmp;
-
-                for (++tmp; done[tmp]; ++tmp);
-                nface.mIndices[2] = tmp;
-
             }
         }
 
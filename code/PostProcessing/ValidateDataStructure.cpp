@@ -58,13 +58,20 @@ using namespace Assimp;
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ValidateDSProcess::ValidateDSProcess() : mScene(nullptr) {}
+ValidateDSProcess::ValidateDSProcess() : mScene(nullptr), mStructuralOnly(false) {}
 
 // ------------------------------------------------------------------------------------------------
 // Returns whether the processing step is present in the given flag field.
 bool ValidateDSProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Setup properties for the step
+void ValidateDSProcess::SetupProperties(const Importer *pImp) {
+    mStructuralOnly = (0 != pImp->GetPropertyInteger(AI_CONFIG_PP_VDS_STRUCTURAL_ONLY, 0));
+}
+
 // ------------------------------------------------------------------------------------------------
 AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) {
     ai_assert(nullptr != msg);
@@ -96,12 +103,22 @@ void ValidateDSProcess::ReportWarning(const char *msg, ...) {
 }
 
 // ------------------------------------------------------------------------------------------------
-inline int HasNameMatch(const aiString &in, aiNode *node) {
-    int result = (node->mName == in ? 1 : 0);
+inline void CollectNodeNames(const aiNode *node, std::unordered_map<std::string, unsigned int> &names) {
+    ++names[std::string(node->mName.data, node->mName.length)];
     for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-        result += HasNameMatch(in, node->mChildren[i]);
+        CollectNodeNames(node->mChildren[i], names);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int ValidateDSProcess::CountNodeNames(const aiString &name) {
+    // the node graph has already been validated at this point, so it is
+    // walked only once and all lookups are answered from the table
+    if (mNodeNames.empty()) {
+        CollectNodeNames(mScene->mRootNode, mNodeNames);
     }
-    return result;
+    std::unordered_map<std::string, unsigned int>::const_iterator it = mNodeNames.find(std::string(name.data, name.length));
+    return it == mNodeNames.end() ? 0 : it->second;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -139,20 +156,23 @@ inline void ValidateDSProcess::DoValidationEx(T **parray, unsigned int size,
         ReportError("aiScene::%s is nullptr (aiScene::%s is %i)",
                 firstName, secondName, size);
     }
-    for (unsigned int i = 0; i < size; ++i) {
-        if (!parray[i]) {
+    // check whether there are duplicate names
+    std::unordered_map<std::string, unsigned int> names;
+    names.reserve(size);
+    for (unsigned int a = 0; a < size; ++a) {
+        if (!parray[a]) {
             ReportError("aiScene::%s[%u] is nullptr (aiScene::%s is %u)",
-                    firstName, i, secondName, size);
+                    firstName, a, secondName, size);
         }
-        Validate(parray[i]);
-
-        // check whether there are duplicate names
-        for (unsigned int a = i + 1; a < size; ++a) {
-            if (parray[i]->mName == parray[a]->mName) {
-                ReportError("aiScene::%s[%u] has the same name as "
-                            "aiScene::%s[%u]",
-                        firstName, i, secondName, a);
-            }
+        Validate(parray[a]);
+
+        const aiString &name = parray[a]->mName;
+        std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> res =
+                names.emplace(std::string(name.data, name.length), a);
+        if (!res.second) {
+            ReportError("aiScene::%s[%u] has the same name as "
+                        "aiScene::%s[%u]",
+                    firstName, res.first->second, secondName, a);
         }
     }
 }
@@ -165,7 +185,7 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T **array, unsigned int
     DoValidationEx(array, size, firstName, secondName);
 
     for (unsigned int i = 0; i < size; ++i) {
-        int res = HasNameMatch(array[i]->mName, mScene->mRootNode);
+        const unsigned int res = CountNodeNames(array[i]->mName);
         if (0 == res) {
             const std::string name = static_cast<char *>(array[i]->mName.data);
             ReportError("aiScene::%s[%i] has no corresponding node in the scene graph (%s)",
@@ -178,10 +198,25 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T **array, unsigned int
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Counts the mesh references of a node and its children.
+static unsigned int CountMeshInstances(const aiNode *pNode) {
+    if (nullptr == pNode) {
+        return 0;
+    }
+    unsigned int count = pNode->mNumMeshes;
+    for (unsigned int i = 0; i < pNode->mNumChildren; ++i) {
+        count += CountMeshInstances(pNode->mChildren[i]);
+    }
+    return count;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void ValidateDSProcess::Execute(aiScene *pScene) {
     mScene = pScene;
+    mNodeNames.clear();
+    mMeshRefs.assign(pScene->mNumMeshes, false);
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess begin");
 
     // validate the node graph of the scene
@@ -236,6 +271,11 @@ void ValidateDSProcess::Execute(aiScene *pScene) {
         ReportError("aiScene::mMaterials is non-null although there are no materials");
     }
 
+    // validate the BVH over the mesh instances
+    if (pScene->mBVH) {
+        Validate(pScene->mBVH, CountMeshInstances(pScene->mRootNode), "aiScene::mBVH");
+    }
+
     //  if (!has)ReportError("The aiScene data structure is empty");
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess end");
 }
@@ -344,31 +384,34 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
     }
 
     // now check whether the face indexing layout is correct:
-    // unique vertices, pseudo-indexed.
-    std::vector<bool> abRefList;
-    abRefList.resize(pMesh->mNumVertices, false);
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        aiFace &face = pMesh->mFaces[i];
-        if (face.mNumIndices > AI_MAX_FACE_INDICES) {
-            ReportError("Face %u has too many faces: %u, but the limit is %u", i, face.mNumIndices, AI_MAX_FACE_INDICES);
-        }
+    // unique vertices, pseudo-indexed. This is the only check which
+    // touches every single index, trusted sources may skip it.
+    if (!mStructuralOnly) {
+        std::vector<bool> abRefList;
+        abRefList.resize(pMesh->mNumVertices, false);
+        for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+            aiFace &face = pMesh->mFaces[i];
+            if (face.mNumIndices > AI_MAX_FACE_INDICES) {
+                ReportError("Face %u has too many faces: %u, but the limit is %u", i, face.mNumIndices, AI_MAX_FACE_INDICES);
+            }
 
-        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
-            if (face.mIndices[a] >= pMesh->mNumVertices) {
-                ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range", i, a);
+            for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+                if (face.mIndices[a] >= pMesh->mNumVertices) {
+                    ReportError("aiMesh::mFaces[%i]::mIndices[%i] is out of range", i, a);
+                }
+                abRefList[face.mIndices[a]] = true;
             }
-            abRefList[face.mIndices[a]] = true;
         }
-    }
 
-    // check whether there are vertices that aren't referenced by a face
-    bool b = false;
-    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-        if (!abRefList[i]) b = true;
-    }
-    abRefList.clear();
-    if (b) {
-        ReportWarning("There are unreferenced vertices");
+        // check whether there are vertices that aren't referenced by a face
+        bool b = false;
+        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+            if (!abRefList[i]) b = true;
+        }
+        abRefList.clear();
+        if (b) {
+            ReportWarning("There are unreferenced vertices");
+        }
     }
 
     // texture channel 2 may not be set if channel 1 is zero ...
@@ -405,13 +448,15 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
                     pMesh->mNumBones);
         }
         std::unique_ptr<float[]> afSum(nullptr);
-        if (pMesh->mNumVertices) {
+        if (pMesh->mNumVertices && !mStructuralOnly) {
             afSum.reset(new float[pMesh->mNumVertices]);
             for (unsigned int i = 0; i < pMesh->mNumVertices; ++i)
                 afSum[i] = 0.0f;
         }
 
         // check whether there are duplicate bone names
+        std::unordered_map<std::string, unsigned int> names;
+        names.reserve(pMesh->mNumBones);
         for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
             const aiBone *bone = pMesh->mBones[i];
             if (bone->mNumWeights > AI_MAX_BONE_WEIGHTS) {
@@ -424,20 +469,17 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
             }
             Validate(pMesh, pMesh->mBones[i], afSum.get());
 
-            for (unsigned int a = i + 1; a < pMesh->mNumBones; ++a) {
-                if (pMesh->mBones[i]->mName == pMesh->mBones[a]->mName) {
-                    const char *name = "unknown";
-                    if (nullptr != pMesh->mBones[i]->mName.C_Str()) {
-                        name = pMesh->mBones[i]->mName.C_Str();
-                    }
-                    ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
-                                "aiMesh::mBones[%i]",
-                            i, name, a);
-                }
+            const aiString &boneName = pMesh->mBones[i]->mName;
+            std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> res =
+                    names.emplace(std::string(boneName.data, boneName.length), i);
+            if (!res.second) {
+                ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
+                            "aiMesh::mBones[%i]",
+                        res.first->second, boneName.C_Str(), i);
             }
         }
         // check whether all bone weights for a vertex sum to 1.0 ...
-        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        for (unsigned int i = 0; afSum && i < pMesh->mNumVertices; ++i) {
             if (afSum[i] && (afSum[i] <= 0.94 || afSum[i] >= 1.05)) {
                 ReportWarning("aiMesh::mVertices[%i]: bone weight sum != 1.0 (sum is %f)", i, afSum[i]);
             }
@@ -445,6 +487,58 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
     } else if (pMesh->mBones) {
         ReportError("aiMesh::mBones is non-null although there are no bones");
     }
+
+    // the meshlets must cover the faces in order
+    if (pMesh->mNumMeshlets) {
+        if (!pMesh->mMeshlets) {
+            ReportError("aiMesh::mMeshlets is nullptr (aiMesh::mNumMeshlets is %i)",
+                    pMesh->mNumMeshlets);
+        }
+        unsigned int next = 0;
+        for (unsigned int i = 0; i < pMesh->mNumMeshlets; ++i) {
+            const aiMeshlet &meshlet = pMesh->mMeshlets[i];
+            if (meshlet.mFaceOffset != next || meshlet.mNumFaces > pMesh->mNumFaces - next) {
+                ReportError("aiMesh::mMeshlets[%i] does not continue the previous meshlet "
+                            "or exceeds aiMesh::mNumFaces",
+                        i);
+            }
+            next += meshlet.mNumFaces;
+        }
+        if (next != pMesh->mNumFaces) {
+            ReportError("aiMesh::mMeshlets do not cover all faces");
+        }
+    } else if (pMesh->mMeshlets) {
+        ReportError("aiMesh::mMeshlets is non-null although there are no meshlets");
+    }
+
+    if (pMesh->mBVH) {
+        Validate(pMesh->mBVH, pMesh->mNumFaces, "aiMesh::mBVH");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::Validate(const aiBVH *pBVH, unsigned int numItems, const char *owner) {
+    if (!pBVH->mNumNodes || !pBVH->mNodes) {
+        ReportError("%s has no nodes", owner);
+    }
+    if (pBVH->mNumPrimitives && !pBVH->mPrimitives) {
+        ReportError("%s::mPrimitives is nullptr (%s::mNumPrimitives is %i)", owner, owner, pBVH->mNumPrimitives);
+    }
+    for (unsigned int i = 0; i < pBVH->mNumNodes; ++i) {
+        const aiBVHNode &node = pBVH->mNodes[i];
+        if (node.mNumPrimitives) {
+            if (node.mOffset > pBVH->mNumPrimitives || node.mNumPrimitives > pBVH->mNumPrimitives - node.mOffset) {
+                ReportError("%s::mNodes[%i] references primitives out of range", owner, i);
+            }
+        } else if (node.mOffset <= i + 1 || node.mOffset >= pBVH->mNumNodes) {
+            ReportError("%s::mNodes[%i] has an invalid second child (%i)", owner, i, node.mOffset);
+        }
+    }
+    for (unsigned int i = 0; i < pBVH->mNumPrimitives; ++i) {
+        if (pBVH->mPrimitives[i] >= numItems) {
+            ReportError("%s::mPrimitives[%i] is out of range (maximum is %i)", owner, i, numItems - 1);
+        }
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -456,6 +550,9 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh, const aiBone *pBone, float
     }
 
     // check whether all vertices affected by this bone are valid
+    if (!afSum) {
+        return;
+    }
     for (unsigned int i = 0; i < pBone->mNumWeights; ++i) {
         if (pBone->mWeights[i].mVertexId >= pMesh->mNumVertices) {
             ReportError("aiBone::mWeights[%i].mVertexId is out of range", i);
@@ -877,18 +974,21 @@ void ValidateDSProcess::Validate(const aiNode *pNode) {
             ReportError("aiNode::mMeshes is nullptr for node %s (aiNode::mNumMeshes is %i)",
                     nodeName, pNode->mNumMeshes);
         }
-        std::vector<bool> abHadMesh;
-        abHadMesh.resize(mScene->mNumMeshes, false);
+        // the scratch buffer is shared by all nodes, so only the
+        // entries set for this node need to be reset afterwards
         for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
             if (pNode->mMeshes[i] >= mScene->mNumMeshes) {
                 ReportError("aiNode::mMeshes[%i] is out of range for node %s (maximum is %i)",
                         pNode->mMeshes[i], nodeName, mScene->mNumMeshes - 1);
             }
-            if (abHadMesh[pNode->mMeshes[i]]) {
+            if (mMeshRefs[pNode->mMeshes[i]]) {
                 ReportError("aiNode::mMeshes[%i] is already referenced by this node %s (value: %i)",
                         i, nodeName, pNode->mMeshes[i]);
             }
-            abHadMesh[pNode->mMeshes[i]] = true;
+            mMeshRefs[pNode->mMeshes[i]] = true;
+        }
+        for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+            mMeshRefs[pNode->mMeshes[i]] = false;
         }
     }
     if (pNode->mNumChildren) {
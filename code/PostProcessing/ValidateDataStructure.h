@@ -51,6 +51,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 struct aiBone;
 struct aiMesh;
 struct aiAnimation;
@@ -62,6 +66,7 @@ struct aiNode;
 struct aiString;
 struct aiCamera;
 struct aiLight;
+struct aiBVH;
 
 namespace Assimp    {
 
@@ -69,7 +74,7 @@ namespace Assimp    {
 /** Validates the whole ASSIMP scene data structure for correctness.
  *  ImportErrorException is thrown of the scene is corrupt.*/
 // --------------------------------------------------------------------------------------
-class ValidateDSProcess : public BaseProcess {
+class ASSIMP_API ValidateDSProcess : public BaseProcess {
 public:
     // -------------------------------------------------------------------
     /// The default class constructor / destructor.
@@ -79,9 +84,26 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const override;
 
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer* pImp) override;
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene) override;
 
+    // -------------------------------------------------------------------
+    /** Skip the checks which are linear in the number of face indices
+     *  and bone weights. See #AI_CONFIG_PP_VDS_STRUCTURAL_ONLY.
+     * @param structuralOnly true to validate the structure only */
+    void EnableStructuralOnly(bool structuralOnly) {
+        mStructuralOnly = structuralOnly;
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns whether only the structure is validated. */
+    bool IsStructuralOnly() const {
+        return mStructuralOnly;
+    }
+
 protected:
     // -------------------------------------------------------------------
     /** Report a validation error. This will throw an exception,
@@ -105,7 +127,8 @@ protected:
     // -------------------------------------------------------------------
     /** Validates a bone
      * @param pMesh Input mesh
-     * @param pBone Input bone*/
+     * @param pBone Input bone
+     * @param afSum Per-vertex weight sums, nullptr to skip the weights*/
     void Validate( const aiMesh* pMesh,const aiBone* pBone,float* afSum);
 
     // -------------------------------------------------------------------
@@ -156,6 +179,13 @@ protected:
     void Validate( const aiAnimation* pAnimation,
         const aiMeshMorphAnim* pMeshMorphAnim);
 
+    // -------------------------------------------------------------------
+    /** Validates a bounding volume hierarchy
+     * @param pBVH Input BVH
+     * @param numItems Number of primitives the BVH may reference
+     * @param owner Name of the owning member, for the error messages*/
+    void Validate( const aiBVH* pBVH, unsigned int numItems, const char* owner);
+
     // -------------------------------------------------------------------
     /** Validates a node and all of its subnodes
      * @param Node Input node*/
@@ -184,7 +214,17 @@ private:
     inline void DoValidationWithNameCheck(T** array, unsigned int size,
         const char* firstName, const char* secondName);
 
+    // counts how often a name occurs in the node graph
+    unsigned int CountNodeNames(const aiString& name);
+
     aiScene* mScene;
+    bool mStructuralOnly;
+
+    // node name -> number of nodes carrying it, built on demand
+    std::unordered_map<std::string, unsigned int> mNodeNames;
+
+    // scratch buffer to find duplicate mesh references of a node
+    std::vector<bool> mMeshRefs;
 };
 
 
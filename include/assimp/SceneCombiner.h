@@ -73,6 +73,7 @@ struct aiAnimMesh;
 struct aiAnimation;
 struct aiNodeAnim;
 struct aiMeshMorphAnim;
+struct aiBVH;
 
 namespace Assimp {
 
@@ -358,6 +359,7 @@ public:
     static void Copy(aiMeshMorphAnim **dest, const aiMeshMorphAnim *src);
     static void Copy(aiMetadata **dest, const aiMetadata *src);
     static void Copy(aiString **dest, const aiString *src);
+    static void Copy(aiBVH **dest, const aiBVH *src);
 
     // recursive, of course
     static void Copy(aiNode **dest, const aiNode *src);
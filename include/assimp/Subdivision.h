@@ -120,6 +120,28 @@ public:
         unsigned int num,
         bool discard_input = false) = 0;
 
+    // ---------------------------------------------------------------
+    /** Limit the number of faces generated by a single call to
+     *  #Subdivide. If performing all requested subdivision steps
+     *  would exceed the limit, fewer steps are performed. All meshes
+     *  passed to one call are refined by the same number of steps.
+     *
+     *  @param max_faces Maximum number of output faces for all meshes
+     *    of a call, 0 to disable the limit (which is the default). */
+    void SetFaceBudget(unsigned int max_faces) {
+        mFaceBudget = max_faces;
+    }
+
+    // ---------------------------------------------------------------
+    /** Get the current face budget, 0 if unlimited. */
+    unsigned int GetFaceBudget() const {
+        return mFaceBudget;
+    }
+
+protected:
+    Subdivider() : mFaceBudget(0) {}
+
+    unsigned int mFaceBudget;
 };
 
 inline Subdivider::~Subdivider() = default;
@@ -123,9 +123,15 @@ public:
     bool hasNode(const std::string &name);
 
     /// @brief  Will parse an xml-file from a given stream.
+    ///
+    /// The stream content is read into a buffer owned by the parser, which is parsed in-situ:
+    /// node names and values point into this buffer instead of being copied by pugixml.
     /// @param[in] stream      The input stream.
+    /// @param[in] options     The pugixml parse options. pugi::parse_minimal skips the processing
+    ///                        of escapes, line ends and attribute values, which is considerably
+    ///                        faster for files holding mostly numeric data.
     /// @return true, if the parsing was successful, false if not.
-    bool parse(IOStream *stream);
+    bool parse(IOStream *stream, unsigned int options = pugi::parse_full);
 
     /// @brief  Will return true if a root node is there.
     /// @return true in case of an existing root.
@@ -248,17 +254,10 @@ inline TXmlParser<TNodeType>::~TXmlParser() {
 
 template <class TNodeType>
 inline void TXmlParser<TNodeType>::clear() {
-    if (mData.empty()) {
-        if (mDoc) {
-            delete mDoc;
-        }
-        mDoc = nullptr;
-        return;
-    }
-
-    mData.clear();
+    // The document was parsed in-situ and points into mData, release it first.
     delete mDoc;
     mDoc = nullptr;
+    mData.clear();
 }
 
 template <class TNodeType>
@@ -286,7 +285,7 @@ bool TXmlParser<TNodeType>::hasNode(const std::string &name) {
 }
 
 template <class TNodeType>
-bool TXmlParser<TNodeType>::parse(IOStream *stream) {
+bool TXmlParser<TNodeType>::parse(IOStream *stream, unsigned int options) {
     if (hasRoot()) {
         clear();
     }
@@ -302,9 +301,8 @@ bool TXmlParser<TNodeType>::parse(IOStream *stream) {
     stream->Read(&mData[0], 1, len);
 
     mDoc = new pugi::xml_document();
-    // load_string assumes native encoding (aka always utf-8 per build options)
-    //pugi::xml_parse_result parse_result = mDoc->load_string(&mData[0], pugi::parse_full);
-     pugi::xml_parse_result parse_result = mDoc->load_buffer(&mData[0], mData.size(), pugi::parse_full);
+    // Parse in-situ, load_buffer would take another copy of the whole file.
+    pugi::xml_parse_result parse_result = mDoc->load_buffer_inplace(&mData[0], mData.size(), options);
     if (parse_result.status == pugi::status_ok) {
         return true;
     }
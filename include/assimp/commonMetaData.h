@@ -66,4 +66,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /// Not all formats add this metadata.
 #define AI_METADATA_SOURCE_COPYRIGHT "SourceAsset_Copyright"
 
+/// Node metadata holding the number of generated levels of detail (uint32),
+/// level 0 being the node's own meshes. See #AI_CONFIG_PP_GLOD_LEVELS.
+#define AI_METADATA_LOD_COUNT "LOD_Count"
+
+/// Prefix of the node metadata keys for the levels of detail, followed by the
+/// level number starting at 1 (e.g. "LOD_Level1"). Each entry is an aiMetadata
+/// holding one uint32 mesh index per entry of aiNode::mMeshes, in order.
+#define AI_METADATA_LOD_LEVEL "LOD_Level"
+
 #endif
@@ -616,6 +616,125 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief A node of a bounding volume hierarchy, see aiBVH.
+ */
+struct aiBVHNode {
+    /** The bounding box of all primitives below this node. */
+    C_STRUCT aiAABB mAABB;
+
+    /** For leaves, the index of the first primitive in aiBVH::mPrimitives.
+     *  For inner nodes, the index of the second child. The first child
+     *  always directly follows its parent.
+     */
+    unsigned int mOffset;
+
+    /** Number of primitives of a leaf, 0 for inner nodes. */
+    unsigned int mNumPrimitives;
+
+#ifdef __cplusplus
+    aiBVHNode() AI_NO_EXCEPT
+            : mAABB(),
+              mOffset(0),
+              mNumPrimitives(0) {
+        // empty
+    }
+
+    //! @brief Check whether the node is a leaf.
+    bool IsLeaf() const {
+        return mNumPrimitives > 0;
+    }
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief A bounding volume hierarchy stored as a flat array of nodes.
+ *
+ * The nodes are stored in depth-first order, node 0 being the root. Each
+ * leaf references a contiguous range of mPrimitives, which holds the indices
+ * of the primitives: faces for aiMesh::mBVH and mesh instances for
+ * aiScene::mBVH. BVHs are generated if #AI_CONFIG_PP_GBVH_MESHES or
+ * #AI_CONFIG_PP_GBVH_SCENE is set.
+ */
+struct aiBVH {
+    /** The number of nodes. */
+    unsigned int mNumNodes;
+
+    /** The nodes of the hierarchy, the root comes first. */
+    C_STRUCT aiBVHNode *mNodes;
+
+    /** The number of primitive indices. */
+    unsigned int mNumPrimitives;
+
+    /** The primitive indices, grouped by leaf. */
+    unsigned int *mPrimitives;
+
+#ifdef __cplusplus
+    aiBVH() AI_NO_EXCEPT
+            : mNumNodes(0),
+              mNodes(nullptr),
+              mNumPrimitives(0),
+              mPrimitives(nullptr) {
+        // empty
+    }
+
+    ~aiBVH() {
+        delete[] mNodes;
+        delete[] mPrimitives;
+    }
+#endif // __cplusplus
+};
+
+// ---------------------------------------------------------------------------
+/** @brief A meshlet is a small cluster of adjacent triangles of a mesh.
+ *
+ * Meshlets are generated if #AI_CONFIG_PP_MESHLET_MAX_VERTICES is set. The
+ * faces of the mesh are sorted so that each meshlet covers a contiguous range
+ * of aiMesh::mFaces. Its bounds and normal cone allow renderers to cull whole
+ * clusters, e.g. in a mesh shader pipeline.
+ */
+struct aiMeshlet {
+    /** Index of the first face of the meshlet in aiMesh::mFaces. */
+    unsigned int mFaceOffset;
+
+    /** Number of faces in the meshlet. */
+    unsigned int mNumFaces;
+
+    /** Number of distinct vertices referenced by the faces. */
+    unsigned int mNumVertices;
+
+    /** The bounding box of the referenced vertices. */
+    C_STRUCT aiAABB mAABB;
+
+    /** Center of the bounding sphere of the referenced vertices. */
+    C_STRUCT aiVector3D mCenter;
+
+    /** Radius of the bounding sphere. */
+    ai_real mRadius;
+
+    /** Axis of the cone containing all face normals, normalized. */
+    C_STRUCT aiVector3D mConeAxis;
+
+    /** Cosine of the half opening angle of the normal cone. If it is
+     *  less than or equal to zero, the cone can't be used for culling.
+     */
+    ai_real mConeCutoff;
+
+#ifdef __cplusplus
+    aiMeshlet() AI_NO_EXCEPT
+            : mFaceOffset(0),
+              mNumFaces(0),
+              mNumVertices(0),
+              mAABB(),
+              mCenter(),
+              mRadius(0),
+              mConeAxis(),
+              mConeCutoff(0) {
+        // empty
+    }
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
  *
@@ -825,6 +944,23 @@ struct aiMesh {
      */
     C_STRUCT aiString **mTextureCoordsNames;
 
+    /**
+     *  The number of meshlets of this mesh.
+     */
+    unsigned int mNumMeshlets;
+
+    /**
+     *  The meshlets the faces are grouped into, sorted by their face offset.
+     *  Only present if #AI_CONFIG_PP_MESHLET_MAX_VERTICES is set.
+     */
+    C_STRUCT aiMeshlet *mMeshlets;
+
+    /**
+     *  Bounding volume hierarchy over the faces of the mesh.
+     *  Only present if #AI_CONFIG_PP_GBVH_MESHES is set.
+     */
+    C_STRUCT aiBVH *mBVH;
+
 #ifdef __cplusplus
 
     //! The default class constructor.
@@ -847,7 +983,10 @@ struct aiMesh {
               mAnimMeshes(nullptr),
               mMethod(aiMorphingMethod_UNKNOWN),
               mAABB(),
-              mTextureCoordsNames(nullptr) {
+              mTextureCoordsNames(nullptr),
+              mNumMeshlets(0),
+              mMeshlets(nullptr),
+              mBVH(nullptr) {
         // empty
     }
 
@@ -894,6 +1033,8 @@ struct aiMesh {
         }
 
         delete[] mFaces;
+        delete[] mMeshlets;
+        delete mBVH;
     }
 
     //! @brief Check whether the mesh contains positions. Provided no special
@@ -973,6 +1114,18 @@ struct aiMesh {
         return mBones != nullptr && mNumBones > 0;
     }
 
+    //! @brief Check whether the mesh contains meshlets.
+    //! @return true, if meshlets are stored.
+    bool HasMeshlets() const {
+        return mMeshlets != nullptr && mNumMeshlets > 0;
+    }
+
+    //! @brief Check whether the mesh contains a bounding volume hierarchy.
+    //! @return true, if a BVH is stored.
+    bool HasBVH() const {
+        return mBVH != nullptr && mBVH->mNumNodes > 0;
+    }
+
     //! @brief  Check whether the mesh contains a texture coordinate set name
     //! @param pIndex Index of the texture coordinates set
     //! @return true, if texture coordinates for the index exists.
@@ -352,6 +352,14 @@ struct aiScene
      */
     C_STRUCT aiSkeleton **mSkeletons;
 
+    /**
+     *  Bounding volume hierarchy over the world-space bounds of all mesh
+     *  instances. The instances are numbered by a depth-first traversal of
+     *  the node graph, visiting the meshes of a node before its children.
+     *  Only present if #AI_CONFIG_PP_GBVH_SCENE is set.
+     */
+    C_STRUCT aiBVH *mBVH;
+
 #ifdef __cplusplus
 
     //! Default constructor - set everything to 0/nullptr
@@ -396,6 +404,11 @@ struct aiScene
         return mSkeletons != nullptr && mNumSkeletons > 0;
     }
 
+    //! Check whether the scene contains a bounding volume hierarchy
+    inline bool HasBVH() const {
+        return mBVH != nullptr && mBVH->mNumNodes > 0;
+    }
+
     //! Returns a short filename from a full path
     static const char* GetShortFilename(const char* filename) {
         const char* lastSlash = strrchr(filename, '/');
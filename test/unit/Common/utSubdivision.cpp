@@ -0,0 +1,105 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+Copyright (c) 2006-2022, assimp team
+All rights reserved.
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+----------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include <assimp/mesh.h>
+#include <assimp/StandardShapes.h>
+#include <assimp/Subdivision.h>
+
+#include <memory>
+
+using namespace Assimp;
+
+class utSubdivision : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mCube = StandardShapes::MakeMesh([](std::vector<aiVector3D> &positions) {
+            return StandardShapes::MakeHexahedron(positions, true);
+        });
+        mSubdivider.reset(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+    }
+
+    void TearDown() override {
+        delete mCube;
+    }
+
+    aiMesh *mCube = nullptr;
+    std::unique_ptr<Subdivider> mSubdivider;
+};
+
+TEST_F(utSubdivision, subdivideCubeTest) {
+    aiMesh *out = nullptr;
+    mSubdivider->Subdivide(mCube, out, 2);
+    ASSERT_NE(nullptr, out);
+
+    // 6 quads -> 24 quads -> 96 quads
+    EXPECT_EQ(96u, out->mNumFaces);
+    for (unsigned int i = 0; i < out->mNumFaces; ++i) {
+        EXPECT_EQ(4u, out->mFaces[i].mNumIndices);
+    }
+
+    // the limit surface lies within the control cage
+    aiVector3D min(1e10f, 1e10f, 1e10f), max(-1e10f, -1e10f, -1e10f);
+    for (unsigned int i = 0; i < mCube->mNumVertices; ++i) {
+        min = aiVector3D(std::min(min.x, mCube->mVertices[i].x), std::min(min.y, mCube->mVertices[i].y), std::min(min.z, mCube->mVertices[i].z));
+        max = aiVector3D(std::max(max.x, mCube->mVertices[i].x), std::max(max.y, mCube->mVertices[i].y), std::max(max.z, mCube->mVertices[i].z));
+    }
+    for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+        const aiVector3D &v = out->mVertices[i];
+        EXPECT_TRUE(v.x >= min.x && v.y >= min.y && v.z >= min.z);
+        EXPECT_TRUE(v.x <= max.x && v.y <= max.y && v.z <= max.z);
+        EXPECT_LT(v.Length(), max.Length());
+    }
+    delete out;
+}
+
+TEST_F(utSubdivision, faceBudgetLimitsStepsTest) {
+    EXPECT_EQ(0u, mSubdivider->GetFaceBudget());
+    mSubdivider->SetFaceBudget(100);
+    EXPECT_EQ(100u, mSubdivider->GetFaceBudget());
+
+    aiMesh *out = nullptr;
+    mSubdivider->Subdivide(mCube, out, 4);
+    ASSERT_NE(nullptr, out);
+    EXPECT_EQ(96u, out->mNumFaces);
+    delete out;
+}
+
+TEST_F(utSubdivision, faceBudgetTooSmallTest) {
+    mSubdivider->SetFaceBudget(10);
+
+    aiMesh *out = nullptr;
+    mSubdivider->Subdivide(mCube, out, 2);
+    ASSERT_NE(nullptr, out);
+    EXPECT_EQ(mCube->mNumFaces, out->mNumFaces);
+    delete out;
+}
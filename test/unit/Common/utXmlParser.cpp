@@ -84,3 +84,30 @@ TEST_F(utXmlParser, parse_xml_and_traverse_test) {
         EXPECT_FALSE(nodeName.empty());
     }
 }
+
+TEST_F(utXmlParser, parse_xml_minimal_test) {
+    XmlParser parser;
+    std::string filename = ASSIMP_TEST_MODELS_DIR "/X3D/ComputerKeyboard.x3d";
+    std::unique_ptr<IOStream> stream(mIoSystem.Open(filename.c_str(), "rb"));
+    EXPECT_NE(stream.get(), nullptr);
+    bool result = parser.parse(stream.get(), pugi::parse_minimal);
+    EXPECT_TRUE(result);
+
+    XmlNode *node = parser.findNode("X3D");
+    ASSERT_NE(nullptr, node);
+    EXPECT_FALSE(node->children().empty());
+}
+
+TEST_F(utXmlParser, parse_xml_twice_test) {
+    XmlParser parser;
+    std::string filename = ASSIMP_TEST_MODELS_DIR "/X3D/ComputerKeyboard.x3d";
+    std::unique_ptr<IOStream> stream(mIoSystem.Open(filename.c_str(), "rb"));
+    EXPECT_NE(stream.get(), nullptr);
+    EXPECT_TRUE(parser.parse(stream.get()));
+    const std::string rootName = parser.getRootNode().first_child().name();
+
+    // the second parse replaces the buffer the first document referred to
+    stream->Seek(0, aiOrigin_SET);
+    EXPECT_TRUE(parser.parse(stream.get()));
+    EXPECT_EQ(rootName, parser.getRootNode().first_child().name());
+}
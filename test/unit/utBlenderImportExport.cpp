@@ -180,6 +180,21 @@ TEST(utBlenderImporter, importSuzanneSubdiv_252) {
     EXPECT_NEAR(vertexAvg.z, 0.31429031491279602, 0.0001);
 }
 
+TEST(utBlenderImporter, importSuzanneSubdivFaceBudget_252) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BLEND/SuzanneSubdiv_252.blend", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const unsigned int numFaces = scene->mMeshes[0]->mNumFaces;
+
+    // a budget just below the full result drops the last subdivision level
+    importer.SetPropertyInteger(AI_CONFIG_IMPORT_BLEND_SUBDIVISION_FACE_BUDGET, numFaces - 1);
+    scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BLEND/SuzanneSubdiv_252.blend", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    EXPECT_EQ(numFaces / 4, scene->mMeshes[0]->mNumFaces);
+}
+
 TEST(utBlenderImporter, importTexturedCube_ImageGlob_248) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/BLEND/TexturedCube_ImageGlob_248.blend", aiProcess_ValidateDataStructure);
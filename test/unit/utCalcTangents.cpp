@@ -0,0 +1,199 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/CalcTangentsProcess.h"
+#include <assimp/mesh.h>
+
+#include <cmath>
+
+using namespace Assimp;
+
+namespace {
+
+class TestCalcTangentsProcess : public CalcTangentsProcess {
+public:
+    using CalcTangentsProcess::ProcessMesh;
+};
+
+} // namespace
+
+class CalcTangentsTest : public ::testing::Test {
+protected:
+    // two triangles in the xy plane sharing the edge between vertex 1 and 2 by
+    // index. The texture coordinates match the positions except for vertex 3,
+    // so the faces have different tangents.
+    void SetUp() override {
+        mMesh = new aiMesh();
+        mMesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mMesh->mNumVertices = 4;
+        mMesh->mVertices = new aiVector3D[4];
+        mMesh->mVertices[0] = aiVector3D(0, 0, 0);
+        mMesh->mVertices[1] = aiVector3D(2, 0, 0);
+        mMesh->mVertices[2] = aiVector3D(0, 1, 0);
+        mMesh->mVertices[3] = aiVector3D(2, 1, 0);
+        mMesh->mNormals = new aiVector3D[4];
+        mMesh->mTextureCoords[0] = new aiVector3D[4];
+        mMesh->mNumUVComponents[0] = 2;
+        for (unsigned int i = 0; i < 4; ++i) {
+            mMesh->mNormals[i] = aiVector3D(0, 0, 1);
+            mMesh->mTextureCoords[0][i] = mMesh->mVertices[i];
+        }
+        mMesh->mTextureCoords[0][3] = aiVector3D(2, 2, 0);
+
+        mMesh->mNumFaces = 2;
+        mMesh->mFaces = new aiFace[2];
+        const unsigned int indices[2][3] = { { 0, 1, 2 }, { 1, 3, 2 } };
+        for (unsigned int f = 0; f < 2; ++f) {
+            mMesh->mFaces[f].mIndices = new unsigned int[mMesh->mFaces[f].mNumIndices = 3];
+            for (unsigned int i = 0; i < 3; ++i) {
+                mMesh->mFaces[f].mIndices[i] = indices[f][i];
+            }
+        }
+    }
+
+    void TearDown() override {
+        delete mMesh;
+    }
+
+    aiMesh *mMesh = nullptr;
+    TestCalcTangentsProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CalcTangentsTest, sharedVerticesAverageFaceTangents) {
+    ASSERT_TRUE(mProcess.ProcessMesh(mMesh, 0));
+
+    const aiVector3D first(1, 0, 0), second = aiVector3D(4, -1, 0).Normalize();
+    EXPECT_TRUE(mMesh->mTangents[0].Equal(first));
+    EXPECT_TRUE(mMesh->mTangents[3].Equal(second));
+
+    // the faces are weighted by their angle at the shared vertex
+    const float small = std::atan(0.5f), large = std::atan(2.0f);
+    EXPECT_TRUE(mMesh->mTangents[1].Equal((first * small + second * large).Normalize()));
+    EXPECT_TRUE(mMesh->mTangents[2].Equal((first * large + second * small).Normalize()));
+
+    for (unsigned int i = 0; i < mMesh->mNumVertices; ++i) {
+        EXPECT_NEAR(1.0f, mMesh->mBitangents[i].Length(), 1e-5f);
+        EXPECT_NEAR(0.0f, mMesh->mBitangents[i] * mMesh->mNormals[i], 1e-5f);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CalcTangentsTest, verboseVerticesKeepFaceTangents) {
+    // the same faces with their own vertices, smoothed by position instead
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 6;
+    mesh->mVertices = new aiVector3D[6];
+    mesh->mNormals = new aiVector3D[6];
+    mesh->mTextureCoords[0] = new aiVector3D[6];
+    mesh->mNumUVComponents[0] = 2;
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int f = 0; f < 2; ++f) {
+        aiFace &face = mesh->mFaces[f];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int src = mMesh->mFaces[f].mIndices[i];
+            face.mIndices[i] = f * 3 + i;
+            mesh->mVertices[f * 3 + i] = mMesh->mVertices[src];
+            mesh->mNormals[f * 3 + i] = mMesh->mNormals[src];
+            mesh->mTextureCoords[0][f * 3 + i] = mMesh->mTextureCoords[0][src];
+        }
+    }
+
+    // the tangent frames of the faces are further apart than the smoothing angle
+    ASSERT_TRUE(mProcess.ProcessMesh(mesh, 0));
+    for (unsigned int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(mesh->mTangents[i].Equal(aiVector3D(1, 0, 0)));
+        EXPECT_TRUE(mesh->mTangents[3 + i].Equal(aiVector3D(4, -1, 0).Normalize()));
+    }
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(CalcTangentsTest, nearlyCoincidentSeamIsSmoothed) {
+    // the shared faces plus a third one below them, whose first vertex is
+    // slightly off vertex 0, well within the position epsilon. Its texture
+    // coordinates are sheared, so its tangent is a bit off the first face's.
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 7;
+    mesh->mVertices = new aiVector3D[7];
+    mesh->mNormals = new aiVector3D[7];
+    mesh->mTextureCoords[0] = new aiVector3D[7];
+    mesh->mNumUVComponents[0] = 2;
+    for (unsigned int i = 0; i < 4; ++i) {
+        mesh->mVertices[i] = mMesh->mVertices[i];
+        mesh->mTextureCoords[0][i] = mMesh->mTextureCoords[0][i];
+    }
+    mesh->mVertices[4] = aiVector3D(1e-6f, 0, 0);
+    mesh->mVertices[5] = aiVector3D(0, -1, 0);
+    mesh->mVertices[6] = aiVector3D(1, -1, 0);
+    for (unsigned int i = 0; i < 7; ++i) {
+        mesh->mNormals[i] = aiVector3D(0, 0, 1);
+    }
+    for (unsigned int i = 4; i < 7; ++i) {
+        const aiVector3D &p = mesh->mVertices[i];
+        mesh->mTextureCoords[0][i] = aiVector3D(p.x, p.y + 0.3f * p.x, 0);
+    }
+
+    mesh->mNumFaces = 3;
+    mesh->mFaces = new aiFace[3];
+    const unsigned int indices[3][3] = { { 0, 1, 2 }, { 1, 3, 2 }, { 4, 5, 6 } };
+    for (unsigned int f = 0; f < 3; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = indices[f][i];
+        }
+    }
+
+    // both sides of the seam are merged into a tangent between the two face tangents
+    ASSERT_TRUE(mProcess.ProcessMesh(mesh, 0));
+    const aiVector3D sheared = aiVector3D(1, -0.3f, 0).Normalize();
+    EXPECT_TRUE(mesh->mTangents[0].Equal(mesh->mTangents[4]));
+    EXPECT_LT(mesh->mTangents[0].y, 0.0f);
+    EXPECT_GT(mesh->mTangents[0].y, sheared.y);
+    EXPECT_TRUE(mesh->mTangents[5].Equal(sheared));
+    delete mesh;
+}
@@ -0,0 +1,155 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/DeboneProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+namespace {
+
+const unsigned int NumBones = 3;
+
+class TestDeboneProcess : public DeboneProcess {
+public:
+    using DeboneProcess::Execute;
+};
+
+} // namespace
+
+class DeboneTest : public ::testing::Test {
+protected:
+    // one triangle per bone, fully bound to it, followed by a triangle without
+    // any bone. The nodes of the bones are children of the root node.
+    void SetUp() override {
+        mScene = new aiScene();
+        mScene->mMaterials = new aiMaterial *[mScene->mNumMaterials = 1];
+        mScene->mMaterials[0] = new aiMaterial();
+        mScene->mMeshes = new aiMesh *[mScene->mNumMeshes = 1];
+
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices = (NumBones + 1) * 3];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i / 3), static_cast<ai_real>(i % 3), 0);
+        }
+        mesh->mFaces = new aiFace[mesh->mNumFaces = NumBones + 1];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            aiFace &face = mesh->mFaces[f];
+            face.mIndices = new unsigned int[face.mNumIndices = 3];
+            for (unsigned int i = 0; i < 3; ++i) {
+                face.mIndices[i] = f * 3 + i;
+            }
+        }
+
+        std::vector<aiNode *> children;
+        mesh->mBones = new aiBone *[mesh->mNumBones = NumBones];
+        for (unsigned int b = 0; b < NumBones; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone();
+            bone->mName.Set("bone_" + std::to_string(b));
+            bone->mOffsetMatrix.a4 = 10.0f;
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights = 3];
+            for (unsigned int i = 0; i < 3; ++i) {
+                bone->mWeights[i] = aiVertexWeight(b * 3 + i, 1.0f);
+            }
+            children.push_back(new aiNode(bone->mName.C_Str()));
+        }
+
+        mScene->mRootNode = new aiNode("root");
+        mScene->mRootNode->mMeshes = new unsigned int[mScene->mRootNode->mNumMeshes = 1];
+        mScene->mRootNode->mMeshes[0] = 0;
+        mScene->mRootNode->addChildren(NumBones, children.data());
+
+        Importer importer;
+        mProcess.SetupProperties(&importer);
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    aiScene *mScene = nullptr;
+    TestDeboneProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(DeboneTest, splitsOffFacesOfRemovableBones) {
+    mProcess.Execute(mScene);
+
+    EXPECT_EQ(NumBones, mProcess.mNumBones);
+    EXPECT_EQ(NumBones, mProcess.mNumBonesCanDoWithout);
+
+    // the unowned triangle stays in front, followed by one boneless mesh per bone
+    ASSERT_EQ(NumBones + 1, mScene->mNumMeshes);
+    EXPECT_EQ(1u, mScene->mMeshes[0]->mNumFaces);
+    EXPECT_EQ(static_cast<ai_real>(NumBones), mScene->mMeshes[0]->mVertices[0].x);
+    for (unsigned int b = 0; b < NumBones; ++b) {
+        const aiMesh *mesh = mScene->mMeshes[b + 1];
+        EXPECT_FALSE(mesh->HasBones());
+        ASSERT_EQ(1u, mesh->mNumFaces);
+        ASSERT_EQ(3u, mesh->mNumVertices);
+
+        // the vertices are moved by the offset matrix of their bone
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            EXPECT_EQ(static_cast<ai_real>(b + 10), mesh->mVertices[i].x);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(DeboneTest, attachesSubmeshesToBoneNodes) {
+    mProcess.Execute(mScene);
+
+    ASSERT_EQ(1u, mScene->mRootNode->mNumMeshes);
+    EXPECT_EQ(0u, mScene->mRootNode->mMeshes[0]);
+
+    ASSERT_EQ(NumBones, mScene->mRootNode->mNumChildren);
+    for (unsigned int b = 0; b < NumBones; ++b) {
+        const aiNode *node = mScene->mRootNode->mChildren[b];
+        ASSERT_EQ(1u, node->mNumMeshes);
+        EXPECT_EQ(b + 1, node->mMeshes[0]);
+    }
+}
@@ -0,0 +1,95 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/EmbedTexturesProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/material.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class EmbedTexturesTest : public ::testing::Test {
+protected:
+    // a scene with one material per texture path
+    aiScene *createScene(const std::vector<std::string> &paths) {
+        aiScene *scene = new aiScene();
+        scene->mRootNode = new aiNode();
+        scene->mNumMaterials = static_cast<unsigned int>(paths.size());
+        scene->mMaterials = new aiMaterial *[scene->mNumMaterials];
+        for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+            aiString path(paths[i]);
+            scene->mMaterials[i] = new aiMaterial();
+            scene->mMaterials[i]->AddProperty(&path, AI_MATKEY_TEXTURE_DIFFUSE(0));
+        }
+        return scene;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(EmbedTexturesTest, embedsEachFileOnce) {
+    // the same file through different relative paths, and a copy of
+    // it with identical content in another folder
+    aiScene *scene = createScene({ "1.png", "./1.png", "../IRR/1.png", "../IRRMesh/1.png", "missing.png" });
+
+    Importer importer;
+    importer.SetPropertyString("sourceFilePath", ASSIMP_TEST_MODELS_DIR "/IRR/box.irr");
+    EmbedTexturesProcess process;
+    process.SetupProperties(&importer);
+    process.Execute(scene);
+
+    ASSERT_EQ(1u, scene->mNumTextures);
+    EXPECT_EQ(0u, scene->mTextures[0]->mHeight);
+    EXPECT_STREQ("png", scene->mTextures[0]->achFormatHint);
+    for (unsigned int i = 0; i < 4; ++i) {
+        aiString path;
+        ASSERT_EQ(AI_SUCCESS, scene->mMaterials[i]->GetTexture(aiTextureType_DIFFUSE, 0, &path));
+        EXPECT_STREQ("*0", path.C_Str());
+    }
+
+    // the missing file is left alone
+    aiString path;
+    ASSERT_EQ(AI_SUCCESS, scene->mMaterials[4]->GetTexture(aiTextureType_DIFFUSE, 0, &path));
+    EXPECT_STREQ("missing.png", path.C_Str());
+    delete scene;
+}
@@ -0,0 +1,137 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/FindInstancesProcess.h"
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class FindInstancesProcessTest : public ::testing::Test {
+protected:
+    static aiMesh *CreateQuad(float offset, unsigned int materialIndex) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mMaterialIndex = materialIndex;
+        mesh->mNumVertices = 6;
+        mesh->mVertices = new aiVector3D[6];
+        const aiVector3D corners[] = { aiVector3D(0, 0, 0), aiVector3D(1, 0, 0), aiVector3D(1, 1, 0),
+            aiVector3D(0, 0, 0), aiVector3D(1, 1, 0), aiVector3D(0, 1, offset) };
+        for (unsigned int i = 0; i < 6; ++i) {
+            mesh->mVertices[i] = corners[i];
+        }
+        mesh->mNumFaces = 2;
+        mesh->mFaces = new aiFace[2];
+        for (unsigned int f = 0; f < 2; ++f) {
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f].mIndices = new unsigned int[3];
+            for (unsigned int i = 0; i < 3; ++i) {
+                mesh->mFaces[f].mIndices[i] = f * 3 + i;
+            }
+        }
+        return mesh;
+    }
+
+    static void AddBone(aiMesh *mesh, float weight) {
+        mesh->mNumBones = 1;
+        mesh->mBones = new aiBone *[1];
+        aiBone *bone = mesh->mBones[0] = new aiBone();
+        bone->mName.Set("bone");
+        bone->mNumWeights = mesh->mNumVertices;
+        bone->mWeights = new aiVertexWeight[mesh->mNumVertices];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            bone->mWeights[i] = aiVertexWeight(i, weight);
+        }
+    }
+
+    static aiScene *CreateScene(const std::vector<aiMesh *> &meshes) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = static_cast<unsigned int>(meshes.size());
+        scene->mMeshes = new aiMesh *[scene->mNumMeshes];
+        scene->mRootNode = new aiNode();
+        scene->mRootNode->mNumMeshes = scene->mNumMeshes;
+        scene->mRootNode->mMeshes = new unsigned int[scene->mNumMeshes];
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            scene->mMeshes[i] = meshes[i];
+            scene->mRootNode->mMeshes[i] = i;
+        }
+        return scene;
+    }
+};
+
+TEST_F(FindInstancesProcessTest, collapseInstancesTest) {
+    aiScene *scene = CreateScene({ CreateQuad(0.f, 0), CreateQuad(1.f, 0), CreateQuad(0.f, 0),
+            CreateQuad(0.f, 1), CreateQuad(1.f, 0) });
+    aiMesh *first = scene->mMeshes[0], *second = scene->mMeshes[1], *third = scene->mMeshes[3];
+
+    FindInstancesProcess process;
+    process.Execute(scene);
+
+    ASSERT_EQ(3u, scene->mNumMeshes);
+    EXPECT_EQ(first, scene->mMeshes[0]);
+    EXPECT_EQ(second, scene->mMeshes[1]);
+    EXPECT_EQ(third, scene->mMeshes[2]);
+
+    const unsigned int expected[] = { 0, 1, 0, 2, 1 };
+    ASSERT_EQ(5u, scene->mRootNode->mNumMeshes);
+    for (unsigned int i = 0; i < 5; ++i) {
+        EXPECT_EQ(expected[i], scene->mRootNode->mMeshes[i]);
+    }
+    delete scene;
+}
+
+TEST_F(FindInstancesProcessTest, compareBoneWeightsTest) {
+    aiMesh *skinned = CreateQuad(0.f, 0), *same = CreateQuad(0.f, 0), *other = CreateQuad(0.f, 0);
+    AddBone(skinned, 1.f);
+    AddBone(same, 1.f);
+    AddBone(other, 0.5f);
+    aiScene *scene = CreateScene({ skinned, same, other });
+
+    FindInstancesProcess process;
+    process.Execute(scene);
+
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    EXPECT_EQ(skinned, scene->mMeshes[0]);
+    EXPECT_EQ(other, scene->mMeshes[1]);
+    EXPECT_EQ(0u, scene->mRootNode->mMeshes[1]);
+    EXPECT_EQ(1u, scene->mRootNode->mMeshes[2]);
+    delete scene;
+}
@@ -0,0 +1,280 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenBVHProcess.h"
+#include "PostProcessing/ValidateDataStructure.h"
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace Assimp;
+
+class GenBVHTest : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 16;
+
+    // a regular grid of quads split into triangles, instanced by three nodes
+    void SetUp() override {
+        mScene = new aiScene();
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+        const unsigned int row = GridSize + 1;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i % row), static_cast<ai_real>(i / row), 0);
+        }
+
+        mesh->mNumFaces = GridSize * GridSize * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int quad = f / 2, x = quad % GridSize, y = quad / GridSize;
+            const unsigned int v = y * row + x;
+            aiFace &face = mesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            face.mIndices[0] = v;
+            face.mIndices[1] = (f % 2) ? v + 1 : v + row + 1;
+            face.mIndices[2] = (f % 2) ? v + row + 1 : v + row;
+        }
+
+        mScene->mMaterials = new aiMaterial *[1];
+        mScene->mMaterials[0] = new aiMaterial();
+        mScene->mNumMaterials = 1;
+
+        aiNode *root = mScene->mRootNode = new aiNode("root");
+        root->mNumChildren = 3;
+        root->mChildren = new aiNode *[3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            aiNode *child = root->mChildren[i] = new aiNode("instance" + std::to_string(i));
+            child->mParent = root;
+            child->mNumMeshes = 1;
+            child->mMeshes = new unsigned int[1];
+            child->mMeshes[0] = 0;
+            aiMatrix4x4::Translation(aiVector3D(0, 0, static_cast<ai_real>(10 * i)), child->mTransformation);
+        }
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    static bool Contains(const aiAABB &outer, const aiAABB &inner) {
+        return outer.mMin.x <= inner.mMin.x && outer.mMin.y <= inner.mMin.y && outer.mMin.z <= inner.mMin.z &&
+               outer.mMax.x >= inner.mMax.x && outer.mMax.y >= inner.mMax.y && outer.mMax.z >= inner.mMax.z;
+    }
+
+    // checks that every primitive is referenced once and the nodes enclose their contents
+    static void CheckBVH(const aiBVH *bvh, const std::vector<aiAABB> &boxes, unsigned int maxLeafSize) {
+        ASSERT_NE(nullptr, bvh);
+        ASSERT_EQ(boxes.size(), bvh->mNumPrimitives);
+        std::vector<unsigned int> refs(boxes.size(), 0);
+        for (unsigned int i = 0; i < bvh->mNumNodes; ++i) {
+            const aiBVHNode &node = bvh->mNodes[i];
+            if (node.IsLeaf()) {
+                EXPECT_LE(node.mNumPrimitives, maxLeafSize);
+                for (unsigned int p = node.mOffset; p < node.mOffset + node.mNumPrimitives; ++p) {
+                    ++refs[bvh->mPrimitives[p]];
+                    EXPECT_TRUE(Contains(node.mAABB, boxes[bvh->mPrimitives[p]]));
+                }
+            } else {
+                EXPECT_TRUE(Contains(node.mAABB, bvh->mNodes[i + 1].mAABB));
+                EXPECT_TRUE(Contains(node.mAABB, bvh->mNodes[node.mOffset].mAABB));
+            }
+        }
+        for (unsigned int count : refs) {
+            EXPECT_EQ(1u, count);
+        }
+    }
+
+    aiScene *mScene = nullptr;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, disabledByDefaultTest) {
+    GenBVHProcess process;
+    process.Execute(mScene);
+    EXPECT_FALSE(mScene->HasBVH());
+    EXPECT_FALSE(mScene->mMeshes[0]->HasBVH());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, meshBVHTest) {
+    GenBVHProcess process;
+    process.SetBuildMeshes(true);
+    process.SetMaxLeafSize(2);
+    process.Execute(mScene);
+
+    const aiMesh *mesh = mScene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasBVH());
+    EXPECT_FALSE(mScene->HasBVH());
+
+    ValidateDSProcess validate;
+    EXPECT_NO_THROW(validate.Execute(mScene));
+
+    std::vector<aiAABB> boxes(mesh->mNumFaces);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const unsigned int *idx = mesh->mFaces[f].mIndices;
+        boxes[f].mMin = boxes[f].mMax = mesh->mVertices[idx[0]];
+        for (unsigned int i = 1; i < 3; ++i) {
+            const aiVector3D &p = mesh->mVertices[idx[i]];
+            boxes[f].mMin = aiVector3D(std::min(boxes[f].mMin.x, p.x), std::min(boxes[f].mMin.y, p.y), 0);
+            boxes[f].mMax = aiVector3D(std::max(boxes[f].mMax.x, p.x), std::max(boxes[f].mMax.y, p.y), 0);
+        }
+    }
+    CheckBVH(mesh->mBVH, boxes, 2);
+    EXPECT_EQ(aiVector3D(0, 0, 0), mesh->mBVH->mNodes[0].mAABB.mMin);
+    EXPECT_EQ(aiVector3D(GridSize, GridSize, 0), mesh->mBVH->mNodes[0].mAABB.mMax);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, sceneBVHTest) {
+    GenBVHProcess process;
+    process.SetBuildScene(true);
+    process.SetMaxLeafSize(1);
+    process.Execute(mScene);
+
+    ASSERT_TRUE(mScene->HasBVH());
+    EXPECT_FALSE(mScene->mMeshes[0]->HasBVH());
+
+    ValidateDSProcess validate;
+    EXPECT_NO_THROW(validate.Execute(mScene));
+
+    // the instances are numbered in node order
+    std::vector<aiAABB> boxes;
+    for (unsigned int i = 0; i < 3; ++i) {
+        const ai_real z = static_cast<ai_real>(10 * i);
+        boxes.emplace_back(aiVector3D(0, 0, z), aiVector3D(GridSize, GridSize, z));
+    }
+    CheckBVH(mScene->mBVH, boxes, 1);
+    EXPECT_EQ(5u, mScene->mBVH->mNumNodes);
+    EXPECT_EQ(aiVector3D(GridSize, GridSize, 20), mScene->mBVH->mNodes[0].mAABB.mMax);
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, assbinRoundTripTest) {
+    GenBVHProcess process;
+    process.SetBuildScene(true);
+    process.SetBuildMeshes(true);
+    process.Execute(mScene);
+
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(mScene, "assbin");
+    ASSERT_NE(nullptr, blob);
+
+    Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(blob->data, blob->size, 0, "assbin");
+    ASSERT_NE(nullptr, scene);
+
+    const aiBVH *expected[] = { mScene->mBVH, mScene->mMeshes[0]->mBVH };
+    const aiBVH *actual[] = { scene->mBVH, scene->mMeshes[0]->mBVH };
+    for (unsigned int b = 0; b < 2; ++b) {
+        ASSERT_NE(nullptr, actual[b]);
+        ASSERT_EQ(expected[b]->mNumNodes, actual[b]->mNumNodes);
+        ASSERT_EQ(expected[b]->mNumPrimitives, actual[b]->mNumPrimitives);
+        for (unsigned int i = 0; i < expected[b]->mNumNodes; ++i) {
+            EXPECT_EQ(expected[b]->mNodes[i].mAABB.mMin, actual[b]->mNodes[i].mAABB.mMin);
+            EXPECT_EQ(expected[b]->mNodes[i].mAABB.mMax, actual[b]->mNodes[i].mAABB.mMax);
+            EXPECT_EQ(expected[b]->mNodes[i].mOffset, actual[b]->mNodes[i].mOffset);
+            EXPECT_EQ(expected[b]->mNodes[i].mNumPrimitives, actual[b]->mNodes[i].mNumPrimitives);
+        }
+        for (unsigned int i = 0; i < expected[b]->mNumPrimitives; ++i) {
+            EXPECT_EQ(expected[b]->mPrimitives[i], actual[b]->mPrimitives[i]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, assbinTrailingDataTest) {
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(mScene, "assbin");
+    ASSERT_NE(nullptr, blob);
+
+    // bytes behind the scene chunk are not taken for a scene BVH
+    std::vector<uint8_t> data(static_cast<const uint8_t *>(blob->data), static_cast<const uint8_t *>(blob->data) + blob->size);
+    data.resize(data.size() + 16, 0xcd);
+
+    Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(data.data(), data.size(), 0, "assbin");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(nullptr, scene->mBVH);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, assbinOlderMinorVersionTest) {
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(mScene, "assbin");
+    ASSERT_NE(nullptr, blob);
+
+    // files written before the BVH chunks were added are still accepted
+    std::vector<uint8_t> data(static_cast<const uint8_t *>(blob->data), static_cast<const uint8_t *>(blob->data) + blob->size);
+    const unsigned int minor = 0;
+    memcpy(data.data() + 44 + sizeof(unsigned int), &minor, sizeof(minor));
+
+    Importer importer;
+    EXPECT_NE(nullptr, importer.ReadFileFromMemory(data.data(), data.size(), 0, "assbin"));
+}
+#endif // ASSIMP_BUILD_NO_EXPORT
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenBVHTest, importerTest) {
+    const char *off = "OFF\n4 2 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n3 0 1 2\n3 0 2 3\n";
+
+    // the properties alone enable the step
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_PP_GBVH_SCENE, true);
+    importer.SetPropertyBool(AI_CONFIG_PP_GBVH_MESHES, true);
+    const aiScene *scene = importer.ReadFileFromMemory(off, strlen(off), 0, "off");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_TRUE(scene->HasBVH());
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    EXPECT_TRUE(scene->mMeshes[0]->HasBVH());
+}
@@ -0,0 +1,223 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenLODsProcess.h"
+#include <assimp/commonMetaData.h>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+
+using namespace Assimp;
+
+class GenLODsTest : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 16;
+
+    // a regular grid of quads split into triangles, z is computed by the
+    // given function
+    template <typename Height>
+    void CreateGrid(Height height) {
+        mScene = new aiScene();
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh();
+        mesh->mName.Set("grid");
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+        const unsigned int row = GridSize + 1;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumUVComponents[0] = 2;
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            const ai_real x = static_cast<ai_real>(i % row), y = static_cast<ai_real>(i / row);
+            mesh->mVertices[i] = aiVector3D(x, y, height(x, y));
+            mesh->mTextureCoords[0][i] = aiVector3D(x, y, 0) / static_cast<ai_real>(GridSize);
+        }
+
+        mesh->mNumFaces = GridSize * GridSize * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int quad = f / 2, x = quad % GridSize, y = quad / GridSize;
+            const unsigned int v = y * row + x;
+            aiFace &face = mesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            if (f % 2) {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + 1;
+                face.mIndices[2] = v + row + 1;
+            } else {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + row + 1;
+                face.mIndices[2] = v + row;
+            }
+        }
+
+        mScene->mRootNode = new aiNode();
+        mScene->mRootNode->mNumMeshes = 1;
+        mScene->mRootNode->mMeshes = new unsigned int[1];
+        mScene->mRootNode->mMeshes[0] = 0;
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    aiScene *mScene = nullptr;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenLODsTest, disabledByDefaultTest) {
+    CreateGrid([](ai_real, ai_real) { return ai_real(0); });
+    GenLODsProcess process;
+    process.Execute(mScene);
+    EXPECT_EQ(1u, mScene->mNumMeshes);
+    EXPECT_EQ(nullptr, mScene->mRootNode->mMetaData);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenLODsTest, flatGridTest) {
+    CreateGrid([](ai_real, ai_real) { return ai_real(0); });
+    GenLODsProcess process;
+    process.SetNumLevels(3);
+    process.Execute(mScene);
+    ASSERT_GE(mScene->mNumMeshes, 3u);
+
+    unsigned int numFaces = mScene->mMeshes[0]->mNumFaces;
+    for (unsigned int m = 1; m < mScene->mNumMeshes; ++m) {
+        const aiMesh *lod = mScene->mMeshes[m];
+        EXPECT_EQ(std::string("grid_LOD") + std::to_string(m), lod->mName.C_Str());
+        EXPECT_LE(lod->mNumFaces, numFaces / 2);
+        EXPECT_GT(lod->mNumFaces, 0u);
+        ASSERT_NE(nullptr, lod->mTextureCoords[0]);
+        numFaces = lod->mNumFaces;
+
+        std::vector<bool> used(lod->mNumVertices, false);
+        for (unsigned int f = 0; f < lod->mNumFaces; ++f) {
+            ASSERT_EQ(3u, lod->mFaces[f].mNumIndices);
+            for (unsigned int i = 0; i < 3; ++i) {
+                ASSERT_LT(lod->mFaces[f].mIndices[i], lod->mNumVertices);
+                used[lod->mFaces[f].mIndices[i]] = true;
+            }
+        }
+        for (unsigned int v = 0; v < lod->mNumVertices; ++v) {
+            EXPECT_TRUE(used[v]);
+            EXPECT_EQ(0, lod->mVertices[v].z);
+            // the border is kept, so the uv mapping is still valid
+            EXPECT_EQ(lod->mVertices[v].x / GridSize, lod->mTextureCoords[0][v].x);
+        }
+    }
+
+    // the node refers to all levels
+    const aiMetadata *meta = mScene->mRootNode->mMetaData;
+    ASSERT_NE(nullptr, meta);
+    uint32_t count = 0;
+    ASSERT_TRUE(meta->Get(AI_METADATA_LOD_COUNT, count));
+    EXPECT_EQ(mScene->mNumMeshes - 1, count);
+    for (uint32_t level = 1; level <= count; ++level) {
+        aiMetadata meshes;
+        ASSERT_TRUE(meta->Get(std::string(AI_METADATA_LOD_LEVEL) + std::to_string(level), meshes));
+        uint32_t index = 0;
+        ASSERT_TRUE(meshes.Get(0u, index));
+        EXPECT_EQ(level, index);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenLODsTest, maxErrorTest) {
+    // any collapse on a paraboloid moves the surface
+    CreateGrid([](ai_real x, ai_real y) { return (x * x + y * y) / GridSize; });
+    GenLODsProcess process;
+    process.SetNumLevels(3);
+    process.SetMaxError(0.f);
+    process.Execute(mScene);
+    EXPECT_EQ(1u, mScene->mNumMeshes);
+
+    process.SetMaxError(1.f);
+    process.Execute(mScene);
+    EXPECT_LT(1u, mScene->mNumMeshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenLODsTest, reapplyTest) {
+    CreateGrid([](ai_real, ai_real) { return ai_real(0); });
+    GenLODsProcess process;
+    process.SetNumLevels(3);
+    process.Execute(mScene);
+    const unsigned int numMeshes = mScene->mNumMeshes;
+    ASSERT_LT(1u, numMeshes);
+    const unsigned int numProperties = mScene->mRootNode->mMetaData->mNumProperties;
+
+    // neither the source mesh nor its levels are simplified again
+    process.Execute(mScene);
+    EXPECT_EQ(numMeshes, mScene->mNumMeshes);
+    EXPECT_EQ(numProperties, mScene->mRootNode->mMetaData->mNumProperties);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenLODsTest, importerTest) {
+    // a flat 4x4 grid, the OFF loader keeps the shared vertices
+    std::string off = "OFF\n25 32 0\n";
+    for (unsigned int i = 0; i < 25; ++i) {
+        off += std::to_string(i % 5) + " " + std::to_string(i / 5) + " 0\n";
+    }
+    for (unsigned int v = 0; v < 20; ++v) {
+        if (v % 5 != 4) {
+            off += "3 " + std::to_string(v) + " " + std::to_string(v + 1) + " " + std::to_string(v + 6) + "\n";
+            off += "3 " + std::to_string(v) + " " + std::to_string(v + 6) + " " + std::to_string(v + 5) + "\n";
+        }
+    }
+
+    // the property alone enables the step
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_GLOD_LEVELS, 2);
+    const aiScene *scene = importer.ReadFileFromMemory(off.c_str(), off.size(), 0, "off");
+    ASSERT_NE(nullptr, scene);
+    const unsigned int numMeshes = scene->mNumMeshes;
+    EXPECT_LT(1u, numMeshes);
+
+    scene = importer.ApplyPostProcessing(aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(numMeshes, scene->mNumMeshes);
+}
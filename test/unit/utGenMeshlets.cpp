@@ -0,0 +1,214 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/GenMeshletsProcess.h"
+#include "PostProcessing/ValidateDataStructure.h"
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <set>
+#include <vector>
+
+using namespace Assimp;
+
+class GenMeshletsTest : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 16;
+
+    // a regular grid of quads split into triangles
+    void SetUp() override {
+        mScene = new aiScene();
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+        const unsigned int row = GridSize + 1;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i % row), static_cast<ai_real>(i / row), 0);
+        }
+
+        mesh->mNumFaces = GridSize * GridSize * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int quad = f / 2, x = quad % GridSize, y = quad / GridSize;
+            const unsigned int v = y * row + x;
+            aiFace &face = mesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            if (f % 2) {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + 1;
+                face.mIndices[2] = v + row + 1;
+            } else {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + row + 1;
+                face.mIndices[2] = v + row;
+            }
+        }
+        mTriangles = GetTriangles(mesh);
+
+        mScene->mRootNode = new aiNode();
+        mScene->mRootNode->mNumMeshes = 1;
+        mScene->mRootNode->mMeshes = new unsigned int[1];
+        mScene->mRootNode->mMeshes[0] = 0;
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    static std::multiset<std::array<unsigned int, 3>> GetTriangles(const aiMesh *mesh) {
+        std::multiset<std::array<unsigned int, 3>> triangles;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int *idx = mesh->mFaces[f].mIndices;
+            triangles.insert({ idx[0], idx[1], idx[2] });
+        }
+        return triangles;
+    }
+
+    // checks the limits and bounds of all meshlets
+    void CheckMeshlets(unsigned int maxVertices, unsigned int maxTriangles) {
+        const aiMesh *mesh = mScene->mMeshes[0];
+        ASSERT_TRUE(mesh->HasMeshlets());
+        EXPECT_EQ(mTriangles, GetTriangles(mesh));
+
+        ValidateDSProcess validate;
+        EXPECT_NO_THROW(validate.Execute(mScene));
+
+        for (unsigned int m = 0; m < mesh->mNumMeshlets; ++m) {
+            const aiMeshlet &meshlet = mesh->mMeshlets[m];
+            EXPECT_GT(meshlet.mNumFaces, 0u);
+            EXPECT_LE(meshlet.mNumFaces, maxTriangles);
+
+            std::set<unsigned int> vertices;
+            for (unsigned int f = meshlet.mFaceOffset; f < meshlet.mFaceOffset + meshlet.mNumFaces; ++f) {
+                vertices.insert(mesh->mFaces[f].mIndices, mesh->mFaces[f].mIndices + 3);
+            }
+            EXPECT_EQ(vertices.size(), meshlet.mNumVertices);
+            EXPECT_LE(meshlet.mNumVertices, maxVertices);
+
+            for (unsigned int v : vertices) {
+                const aiVector3D &p = mesh->mVertices[v];
+                EXPECT_TRUE(p.x >= meshlet.mAABB.mMin.x && p.y >= meshlet.mAABB.mMin.y && p.z >= meshlet.mAABB.mMin.z);
+                EXPECT_TRUE(p.x <= meshlet.mAABB.mMax.x && p.y <= meshlet.mAABB.mMax.y && p.z <= meshlet.mAABB.mMax.z);
+                EXPECT_LE((p - meshlet.mCenter).Length(), meshlet.mRadius + 1e-4f);
+            }
+
+            // all faces of the grid face +z
+            EXPECT_NEAR(1.0, meshlet.mConeAxis.z, 1e-5);
+            EXPECT_NEAR(1.0, meshlet.mConeCutoff, 1e-5);
+        }
+    }
+
+    aiScene *mScene = nullptr;
+    std::multiset<std::array<unsigned int, 3>> mTriangles;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, disabledByDefaultTest) {
+    GenMeshletsProcess process;
+    process.Execute(mScene);
+    EXPECT_FALSE(mScene->mMeshes[0]->HasMeshlets());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, vertexLimitTest) {
+    GenMeshletsProcess process;
+    process.SetMaxVertices(64);
+    process.Execute(mScene);
+    CheckMeshlets(64, 124);
+
+    // 289 vertices need at least five meshlets, growing along the
+    // adjacency should not need many more than that
+    EXPECT_LE(5u, mScene->mMeshes[0]->mNumMeshlets);
+    EXPECT_GE(8u, mScene->mMeshes[0]->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, triangleLimitTest) {
+    GenMeshletsProcess process;
+    process.SetMaxVertices(256);
+    process.SetMaxTriangles(10);
+    process.Execute(mScene);
+    CheckMeshlets(256, 10);
+    EXPECT_EQ(52u, mScene->mMeshes[0]->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, reapplyTest) {
+    GenMeshletsProcess process;
+    process.SetMaxVertices(64);
+    process.Execute(mScene);
+    const unsigned int numMeshlets = mScene->mMeshes[0]->mNumMeshlets;
+
+    // the meshlets still match the faces and are kept
+    process.SetMaxTriangles(10);
+    process.Execute(mScene);
+    EXPECT_EQ(numMeshlets, mScene->mMeshes[0]->mNumMeshlets);
+
+    // dropping a face invalidates them
+    aiMesh *mesh = mScene->mMeshes[0];
+    --mesh->mNumFaces;
+    mTriangles = GetTriangles(mesh);
+    process.Execute(mScene);
+    CheckMeshlets(64, 10);
+    EXPECT_LT(numMeshlets, mesh->mNumMeshlets);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenMeshletsTest, importerTest) {
+    const char *off = "OFF\n4 2 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n3 0 1 2\n3 0 2 3\n";
+
+    // the property alone enables the step
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_MESHLET_MAX_VERTICES, 64);
+    const aiScene *scene = importer.ReadFileFromMemory(off, strlen(off), 0, "off");
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    EXPECT_EQ(1u, scene->mMeshes[0]->mNumMeshlets);
+}
@@ -84,3 +84,132 @@ TEST_F(GenNormalsTest, testSimpleTriangle) {
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != nullptr);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVertices) {
+    // two triangles folded along the edge they share by index
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 4;
+    mesh->mVertices = new aiVector3D[4];
+    mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(0.0f, 0.0f, 1.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    const unsigned int indices[2][3] = { { 0, 1, 2 }, { 0, 3, 1 } };
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = indices[f][i];
+        }
+    }
+
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    const ai_real h = std::sqrt(ai_real(0.5));
+    EXPECT_TRUE(mesh->mNormals[0].Equal(aiVector3D(0, h, h)));
+    EXPECT_TRUE(mesh->mNormals[1].Equal(aiVector3D(0, h, h)));
+    EXPECT_TRUE(mesh->mNormals[2].Equal(aiVector3D(0, 0, 1)));
+    EXPECT_TRUE(mesh->mNormals[3].Equal(aiVector3D(0, 1, 0)));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testAreaWeightedSharedVertices) {
+    // a small and a large triangle folded along the edge they share by index
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 4;
+    mesh->mVertices = new aiVector3D[4];
+    mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(0.0f, 0.0f, 3.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    const unsigned int indices[2][3] = { { 0, 1, 2 }, { 0, 3, 1 } };
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = indices[f][i];
+        }
+    }
+
+    // the second triangle has three times the area of the first one
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    const aiVector3D expected = aiVector3D(0, 3, 1).Normalize();
+    EXPECT_TRUE(mesh->mNormals[0].Equal(expected));
+    EXPECT_TRUE(mesh->mNormals[1].Equal(expected));
+    EXPECT_TRUE(mesh->mNormals[2].Equal(aiVector3D(0, 0, 1)));
+    EXPECT_TRUE(mesh->mNormals[3].Equal(aiVector3D(0, 1, 0)));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSmoothingAngleComparesFaceNormals) {
+    // two triangles sharing vertex 0 by index at a right angle, and a third
+    // triangle parallel to the first one with its own vertex at the same place
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 7;
+    mesh->mVertices = new aiVector3D[7];
+    mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(0.0f, 0.0f, 1.0f);
+    mesh->mVertices[4] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[5] = aiVector3D(-1.0f, 0.0f, 0.0f);
+    mesh->mVertices[6] = aiVector3D(0.0f, -1.0f, 0.0f);
+    mesh->mNumFaces = 3;
+    mesh->mFaces = new aiFace[3];
+    const unsigned int indices[3][3] = { { 0, 1, 2 }, { 0, 3, 1 }, { 4, 5, 6 } };
+    for (unsigned int f = 0; f < 3; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = indices[f][i];
+        }
+    }
+
+    // the third triangle is within the limit of the first one, though not
+    // of the average normal of vertex 0
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(30.0f));
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    const ai_real h = std::sqrt(ai_real(0.5));
+    EXPECT_TRUE(mesh->mNormals[0].Equal(aiVector3D(0, h, 1 + h).Normalize()));
+    EXPECT_TRUE(mesh->mNormals[4].Equal(aiVector3D(0, 0, 1)));
+    EXPECT_TRUE(mesh->mNormals[5].Equal(aiVector3D(0, 0, 1)));
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testNearlyCoincidentSeam) {
+    // two triangles sharing vertex 1 by index at a right angle, with a seam at
+    // the origin where vertex 3 is slightly off vertex 0, well within the
+    // position epsilon
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 5;
+    mesh->mVertices = new aiVector3D[5];
+    mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[2] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(1e-6f, 0.0f, 0.0f);
+    mesh->mVertices[4] = aiVector3D(0.0f, 0.0f, 1.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    const unsigned int indices[2][3] = { { 0, 1, 2 }, { 3, 4, 1 } };
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mIndices = new unsigned int[mesh->mFaces[f].mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = indices[f][i];
+        }
+    }
+
+    // the seam is smoothed by position like an exact one
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    const aiVector3D expected = aiVector3D(0, 1, 1).Normalize();
+    EXPECT_TRUE(mesh->mNormals[0].Equal(expected));
+    EXPECT_TRUE(mesh->mNormals[3].Equal(expected));
+    delete mesh;
+}
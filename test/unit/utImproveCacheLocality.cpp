@@ -40,3 +40,154 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "UnitTestPCH.h"
+
+#include "PostProcessing/ImproveCacheLocality.h"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+using namespace Assimp;
+
+class ImproveCacheLocalityTest : public ::testing::Test {
+protected:
+    static const unsigned int GridSize = 16;
+
+    // a regular grid of quads split into triangles, the faces are shuffled so
+    // there is something to optimize
+    void SetUp() override {
+        mScene = new aiScene();
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+
+        const unsigned int row = GridSize + 1;
+        mesh->mNumVertices = row * row;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i % row), static_cast<ai_real>(i / row), 0);
+            mesh->mTextureCoords[0][i] = mesh->mVertices[i] / static_cast<ai_real>(GridSize);
+        }
+
+        mesh->mNumFaces = GridSize * GridSize * 2;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            // 97 is coprime to the number of faces
+            const unsigned int src = (f * 97) % mesh->mNumFaces;
+            const unsigned int quad = src / 2, x = quad % GridSize, y = quad / GridSize;
+            const unsigned int v = y * row + x;
+            aiFace &face = mesh->mFaces[f];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[3];
+            if (src % 2) {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + 1;
+                face.mIndices[2] = v + row + 1;
+            } else {
+                face.mIndices[0] = v;
+                face.mIndices[1] = v + row + 1;
+                face.mIndices[2] = v + row;
+            }
+        }
+        mTriangles = GetTriangles(mesh);
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    // triangles by vertex position, rotated to start with the smallest corner position
+    static std::vector<std::array<ai_real, 6>> GetTriangles(const aiMesh *mesh) {
+        std::vector<std::array<ai_real, 6>> triangles;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int *idx = mesh->mFaces[f].mIndices;
+            std::array<ai_real, 6> tri = {};
+            for (unsigned int first = 0; first < 3; ++first) {
+                std::array<ai_real, 6> rotated;
+                for (unsigned int i = 0; i < 3; ++i) {
+                    const aiVector3D &pos = mesh->mVertices[idx[(first + i) % 3]];
+                    rotated[i * 2] = pos.x;
+                    rotated[i * 2 + 1] = pos.y;
+                }
+                if (!first || rotated < tri) {
+                    tri = rotated;
+                }
+            }
+            triangles.push_back(tri);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    static unsigned int CountCacheMisses(const aiMesh *mesh, unsigned int cacheSize) {
+        std::vector<unsigned int> fifo;
+        unsigned int misses = 0;
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                const unsigned int idx = mesh->mFaces[f].mIndices[i];
+                if (std::find(fifo.begin(), fifo.end(), idx) == fifo.end()) {
+                    ++misses;
+                    fifo.push_back(idx);
+                    if (fifo.size() > cacheSize) {
+                        fifo.erase(fifo.begin());
+                    }
+                }
+            }
+        }
+        return misses;
+    }
+
+    void Run(int method, bool reorder) {
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_ICL_METHOD, method);
+        importer.SetPropertyBool(AI_CONFIG_PP_ICL_REORDER_VERTICES, reorder);
+
+        const aiMesh *mesh = mScene->mMeshes[0];
+        const unsigned int missesBefore = CountCacheMisses(mesh, PP_ICL_PTCACHE_SIZE);
+
+        ImproveCacheLocalityProcess process;
+        process.SetupProperties(&importer);
+        process.Execute(mScene);
+
+        EXPECT_EQ(mTriangles, GetTriangles(mesh));
+        EXPECT_LT(CountCacheMisses(mesh, PP_ICL_PTCACHE_SIZE), missesBefore / 2);
+    }
+
+    aiScene *mScene;
+    std::vector<std::array<ai_real, 6>> mTriangles;
+};
+
+TEST_F(ImproveCacheLocalityTest, tipsifyTest) {
+    Run(AI_ICL_METHOD_TIPSIFY, false);
+}
+
+TEST_F(ImproveCacheLocalityTest, forsythTest) {
+    Run(AI_ICL_METHOD_FORSYTH, false);
+}
+
+TEST_F(ImproveCacheLocalityTest, reorderVerticesTest) {
+    Run(AI_ICL_METHOD_FORSYTH, true);
+
+    // the vertices are numbered by their first use now
+    const aiMesh *mesh = mScene->mMeshes[0];
+    unsigned int next = 0;
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int idx = mesh->mFaces[f].mIndices[i];
+            EXPECT_LE(idx, next);
+            if (idx == next) {
+                ++next;
+            }
+        }
+    }
+    EXPECT_EQ(mesh->mNumVertices, next);
+
+    // and the other vertex components moved along
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(mesh->mVertices[i] / static_cast<ai_real>(GridSize), mesh->mTextureCoords[0][i]);
+    }
+}
@@ -134,3 +134,32 @@ TEST_F(LimitBoneWeightsTest, testProcess) {
 
     // everything seems to be OK
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testKeepsLargestWeights) {
+    // one vertex influenced by 8 bones, bones 1 and 2 share the same weight
+    static const float weights[8] = { 0.05f, 0.2f, 0.2f, 0.1f, 0.3f, 0.05f, 0.08f, 0.02f };
+    aiMesh *mesh = new aiMesh();
+    mesh->mNumVertices = 2;
+    mesh->mVertices = new aiVector3D[2];
+    mesh->mBones = new aiBone *[mesh->mNumBones = 8];
+    for (unsigned int i = 0; i < 8; ++i) {
+        aiBone *bone = mesh->mBones[i] = new aiBone();
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights = 2];
+        bone->mWeights[0] = aiVertexWeight(0, weights[i]);
+        bone->mWeights[1] = aiVertexWeight(7, 1.0f); // out of range, dropped
+    }
+
+    mProcess->ProcessMesh(mesh);
+
+    // bones 4, 1, 2 and 3 are kept and renormalized, the others are removed
+    ASSERT_EQ(4u, mesh->mNumBones);
+    static const unsigned int kept[4] = { 1, 2, 3, 4 };
+    for (unsigned int i = 0; i < 4; ++i) {
+        const aiBone *bone = mesh->mBones[i];
+        ASSERT_EQ(1u, bone->mNumWeights);
+        EXPECT_EQ(0u, bone->mWeights[0].mVertexId);
+        EXPECT_NEAR(weights[kept[i]] / 0.8f, bone->mWeights[0].mWeight, 1e-6f);
+    }
+    delete mesh;
+}
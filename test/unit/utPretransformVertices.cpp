@@ -155,3 +155,41 @@ TEST_F(PretransformVerticesTest, testProcessKeepHierarchy) {
     EXPECT_EQ(5U, mScene->mNumMaterials);
     EXPECT_EQ(49U, mScene->mNumMeshes); // see note on mesh 12 above
 }
+
+// ------------------------------------------------------------------------------------------------
+static void CountInstancedVertices(const aiScene *scene, const aiNode *nd, unsigned int &numVertices, unsigned int &numFaces) {
+    for (unsigned int i = 0; i < nd->mNumMeshes; ++i) {
+        numVertices += scene->mMeshes[nd->mMeshes[i]]->mNumVertices;
+        numFaces += scene->mMeshes[nd->mMeshes[i]]->mNumFaces;
+    }
+    for (unsigned int i = 0; i < nd->mNumChildren; ++i) {
+        CountInstancedVertices(scene, nd->mChildren[i], numVertices, numFaces);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testProcessCollapseInstances) {
+    unsigned int numVertices = 0, numFaces = 0;
+    CountInstancedVertices(mScene, mScene->mRootNode, numVertices, numFaces);
+
+    mProcess->KeepHierarchy(false);
+    mProcess->Execute(mScene);
+
+    // every reference to a mesh produces its own transformed copy
+    unsigned int outVertices = 0, outFaces = 0;
+    for (unsigned int i = 0; i < mScene->mNumMeshes; ++i) {
+        const aiMesh *mesh = mScene->mMeshes[i];
+        outVertices += mesh->mNumVertices;
+        outFaces += mesh->mNumFaces;
+        EXPECT_EQ(0U, mesh->mNumBones);
+    }
+    EXPECT_EQ(numVertices, outVertices);
+    EXPECT_EQ(numFaces, outFaces);
+
+    // the first output mesh holds material 0 without normals, starting
+    // with mesh 0 as referenced by node "20"
+    const aiMesh *mesh = mScene->mMeshes[0];
+    EXPECT_EQ(0U, mesh->mMaterialIndex);
+    EXPECT_FALSE(mesh->HasNormals());
+    EXPECT_EQ(aiVector3D(0.f, 1.f, 0.f), mesh->mVertices[1]);
+}
@@ -175,3 +175,64 @@ TEST_F(RemoveRedundantMatsTest, testRedundantMaterialsWithExcludeList) {
     EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[3], AI_MATKEY_NAME, &sName));
     EXPECT_STREQ("Complex material name", sName.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testPropertyOrderIsIgnored) {
+    // material 4 gets the properties of material 0 in reverse order
+    delete pcScene1->mMaterials[4];
+    aiMaterial *pcMat = pcScene1->mMaterials[4] = new aiMaterial();
+    float f = 2.0f;
+    pcMat->AddProperty<float>(&f, 1, AI_MATKEY_SHININESS_STRENGTH);
+    pcMat->AddProperty<float>(&f, 1, AI_MATKEY_BUMPSCALING);
+
+    piProcess->SetFixedMaterialsString();
+    piProcess->Execute(pcScene1);
+    EXPECT_EQ(2U, pcScene1->mNumMaterials);
+    EXPECT_EQ(0U, pcScene1->mMeshes[4]->mMaterialIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testCompareEmbeddedTextures) {
+    // two embedded textures with the same content, the duplicated
+    // materials 1 and 3 each reference one of them
+    pcScene1->mNumTextures = 2;
+    pcScene1->mTextures = new aiTexture *[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        aiTexture *tex = pcScene1->mTextures[i] = new aiTexture();
+        tex->mWidth = tex->mHeight = 2;
+        tex->pcData = new aiTexel[4];
+        for (unsigned int t = 0; t < 4; ++t) {
+            tex->pcData[t].r = tex->pcData[t].g = tex->pcData[t].b = tex->pcData[t].a = static_cast<unsigned char>(t * 60);
+        }
+    }
+    aiString path("*0");
+    pcScene1->mMaterials[1]->AddProperty(&path, AI_MATKEY_TEXTURE_DIFFUSE(0));
+    path.Set("*1");
+    pcScene1->mMaterials[3]->AddProperty(&path, AI_MATKEY_TEXTURE_DIFFUSE(0));
+
+    piProcess->SetFixedMaterialsString();
+    piProcess->SetCompareTextures(true);
+    piProcess->Execute(pcScene1);
+    EXPECT_EQ(3U, pcScene1->mNumMaterials);
+    EXPECT_EQ(1U, pcScene1->mMeshes[3]->mMaterialIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testEmbeddedTexturesComparedByPath) {
+    pcScene1->mNumTextures = 2;
+    pcScene1->mTextures = new aiTexture *[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        aiTexture *tex = pcScene1->mTextures[i] = new aiTexture();
+        tex->mWidth = tex->mHeight = 1;
+        tex->pcData = new aiTexel[1];
+    }
+    aiString path("*0");
+    pcScene1->mMaterials[1]->AddProperty(&path, AI_MATKEY_TEXTURE_DIFFUSE(0));
+    path.Set("*1");
+    pcScene1->mMaterials[3]->AddProperty(&path, AI_MATKEY_TEXTURE_DIFFUSE(0));
+
+    // by default only the texture paths are compared
+    piProcess->SetFixedMaterialsString();
+    piProcess->Execute(pcScene1);
+    EXPECT_EQ(4U, pcScene1->mNumMaterials);
+}
@@ -67,5 +67,30 @@ TEST_F(utScaleProcess, accessScaleTest) {
     EXPECT_FLOAT_EQ(2.0f, process.getScale());
 }
 
+TEST_F(utScaleProcess, scalesTranslationsOnly) {
+    float opacity;
+    aiScene *scene = TestModelFacttory::createDefaultTestModel(opacity);
+    aiMesh *mesh = scene->mMeshes[0];
+    const aiVector3D vertex = mesh->mVertices[1];
+
+    // a node with rotation, non-uniform scale and translation
+    aiMatrix4x4 rotation, scaling, translation;
+    aiMatrix4x4::RotationZ(0.5f, rotation);
+    aiMatrix4x4::Scaling(aiVector3D(1.0f, 2.0f, 3.0f), scaling);
+    aiMatrix4x4::Translation(aiVector3D(1.0f, -2.0f, 4.0f), translation);
+    scene->mRootNode->mTransformation = translation * rotation * scaling;
+
+    ScaleProcess process;
+    process.setScale(10.0f);
+    process.Execute(scene);
+
+    aiMatrix4x4::Translation(aiVector3D(10.0f, -20.0f, 40.0f), translation);
+    const aiMatrix4x4 expected = translation * rotation * scaling;
+    EXPECT_TRUE(expected.Equal(scene->mRootNode->mTransformation, 1e-5f));
+    EXPECT_EQ(vertex * 10.0f, mesh->mVertices[1]);
+
+    TestModelFacttory::releaseDefaultTestModel(&scene);
+}
+
 } // Namespace UnitTest
 } // Namespace Assimp
@@ -71,6 +71,43 @@ TEST_F(utSceneCombiner, MergeMeshes_ValidNames_Test) {
     EXPECT_EQ("mesh_1.mesh_2.mesh_3", outName);
 }
 
+TEST_F(utSceneCombiner, MergeMeshes_SharedBones_Test) {
+    // every mesh has one vertex, bound to a bone shared by all meshes
+    // and to a bone of its own
+    std::vector<aiMesh *> merge_list;
+    for (unsigned int i = 0; i < 100; ++i) {
+        aiMesh *mesh = new aiMesh;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices = 1];
+        mesh->mBones = new aiBone *[mesh->mNumBones = 2];
+        for (unsigned int b = 0; b < 2; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone;
+            bone->mName.Set(b == 0 ? std::string("shared") : "bone_" + std::to_string(i));
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights = 1];
+            bone->mWeights[0] = aiVertexWeight(0, 0.5f);
+        }
+        merge_list.push_back(mesh);
+    }
+
+    aiMesh *ptr = nullptr;
+    SceneCombiner::MergeMeshes(&ptr, 0, merge_list.begin(), merge_list.end());
+    std::unique_ptr<aiMesh> out(ptr);
+    ASSERT_NE(nullptr, out);
+    EXPECT_EQ(100u, out->mNumVertices);
+    ASSERT_EQ(101u, out->mNumBones);
+
+    const aiBone *shared = out->mBones[0];
+    EXPECT_STREQ("shared", shared->mName.C_Str());
+    ASSERT_EQ(100u, shared->mNumWeights);
+    for (unsigned int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, shared->mWeights[i].mVertexId);
+
+        const aiBone *own = out->mBones[i + 1];
+        EXPECT_EQ("bone_" + std::to_string(i), std::string(own->mName.C_Str()));
+        ASSERT_EQ(1u, own->mNumWeights);
+        EXPECT_EQ(i, own->mWeights[0].mVertexId);
+    }
+}
+
 TEST_F(utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion) {
     EXPECT_NO_THROW(SceneCombiner::CopyScene(nullptr, nullptr));
     EXPECT_NO_THROW(SceneCombiner::CopySceneFlat(nullptr, nullptr));
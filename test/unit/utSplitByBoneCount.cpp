@@ -0,0 +1,221 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2023, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/SplitByBoneCountProcess.h"
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+namespace {
+
+class TestSplitByBoneCountProcess : public SplitByBoneCountProcess {
+public:
+    using SplitByBoneCountProcess::Execute;
+};
+
+} // namespace
+
+class SplitByBoneCountTest : public ::testing::Test {
+protected:
+    static const unsigned int NumColumns = 40;
+
+    // a strip of quads, the two vertices of column i are bound to bone i. The
+    // quads are referenced by the root node and a child node.
+    void SetUp() override {
+        mScene = new aiScene();
+        mScene->mMaterials = new aiMaterial *[mScene->mNumMaterials = 1];
+        mScene->mMaterials[0] = new aiMaterial();
+        mScene->mMeshes = new aiMesh *[mScene->mNumMeshes = 2];
+
+        // a small mesh in front, so the indices of the split mesh move
+        aiMesh *first = mScene->mMeshes[0] = new aiMesh();
+        first->mVertices = new aiVector3D[first->mNumVertices = 1];
+        first->mFaces = new aiFace[first->mNumFaces = 1];
+        first->mFaces[0].mIndices = new unsigned int[first->mFaces[0].mNumIndices = 1];
+        first->mFaces[0].mIndices[0] = 0;
+
+        aiMesh *mesh = mScene->mMeshes[1] = new aiMesh();
+        mesh->mName.Set("strip");
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices = NumColumns * 2];
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+            mesh->mVertices[i] = aiVector3D(static_cast<ai_real>(i / 2), static_cast<ai_real>(i % 2), 0);
+        }
+        mesh->mFaces = new aiFace[mesh->mNumFaces = NumColumns - 1];
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            aiFace &face = mesh->mFaces[f];
+            face.mIndices = new unsigned int[face.mNumIndices = 4];
+            face.mIndices[0] = f * 2;
+            face.mIndices[1] = f * 2 + 2;
+            face.mIndices[2] = f * 2 + 3;
+            face.mIndices[3] = f * 2 + 1;
+        }
+        mesh->mBones = new aiBone *[mesh->mNumBones = NumColumns];
+        for (unsigned int b = 0; b < NumColumns; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone();
+            bone->mName.Set("bone_" + std::to_string(b));
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights = 2];
+            bone->mWeights[0] = aiVertexWeight(b * 2, 1.0f);
+            bone->mWeights[1] = aiVertexWeight(b * 2 + 1, 1.0f);
+        }
+
+        mScene->mRootNode = new aiNode("root");
+        mScene->mRootNode->mMeshes = new unsigned int[mScene->mRootNode->mNumMeshes = 1];
+        mScene->mRootNode->mMeshes[0] = 0;
+        aiNode *child = new aiNode("child");
+        mScene->mRootNode->addChildren(1, &child);
+        child->mMeshes = new unsigned int[child->mNumMeshes = 1];
+        child->mMeshes[0] = 1;
+
+        Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES, 8);
+        mProcess.SetupProperties(&importer);
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    aiScene *mScene = nullptr;
+    TestSplitByBoneCountProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, splitsIntoFewestSubmeshes) {
+    mProcess.Execute(mScene);
+
+    // every submesh holds 7 quads with their 8 bones, the last one the remaining 4
+    ASSERT_EQ(7u, mScene->mNumMeshes);
+    unsigned int numFaces = 0;
+    for (unsigned int m = 1; m < mScene->mNumMeshes; ++m) {
+        const aiMesh *mesh = mScene->mMeshes[m];
+        EXPECT_LE(mesh->mNumBones, 8u);
+        numFaces += mesh->mNumFaces;
+
+        // vertices shared by the quads are not duplicated
+        EXPECT_EQ(mesh->mNumBones * 2, mesh->mNumVertices);
+
+        // each bone still influences the vertices of its own column
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone *bone = mesh->mBones[b];
+            ASSERT_EQ(2u, bone->mNumWeights);
+            const ai_real column = static_cast<ai_real>(std::stoi(bone->mName.C_Str() + 5));
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                EXPECT_EQ(column, mesh->mVertices[bone->mWeights[w].mVertexId].x);
+            }
+        }
+    }
+    EXPECT_EQ(NumColumns - 1, numFaces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, updatesNodeMeshIndices) {
+    mProcess.Execute(mScene);
+
+    ASSERT_EQ(1u, mScene->mRootNode->mNumMeshes);
+    EXPECT_EQ(0u, mScene->mRootNode->mMeshes[0]);
+
+    const aiNode *child = mScene->mRootNode->mChildren[0];
+    ASSERT_EQ(mScene->mNumMeshes - 1, child->mNumMeshes);
+    for (unsigned int i = 0; i < child->mNumMeshes; ++i) {
+        EXPECT_EQ(i + 1, child->mMeshes[i]);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, groupsFacesIndependentOfFaceOrder) {
+    // two chains of bones, 0-1-2-3 and 4-5-6-7, with the faces of both chains interleaved.
+    // Taking the faces in their order fills the first submesh with bones 0, 1, 4 and 5,
+    // which ends up with three submeshes instead of one per chain.
+    static const unsigned int FaceBones[6][2] = { { 0, 1 }, { 4, 5 }, { 1, 2 }, { 5, 6 }, { 2, 3 }, { 6, 7 } };
+
+    aiMesh *mesh = mScene->mMeshes[1];
+    delete[] mesh->mVertices;
+    delete[] mesh->mFaces;
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        delete mesh->mBones[b];
+    }
+    delete[] mesh->mBones;
+
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices = 6 * 3];
+    mesh->mFaces = new aiFace[mesh->mNumFaces = 6];
+    std::vector<std::vector<aiVertexWeight>> weights(8);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace &face = mesh->mFaces[f];
+        face.mIndices = new unsigned int[face.mNumIndices = 3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            face.mIndices[i] = f * 3 + i;
+            mesh->mVertices[f * 3 + i] = aiVector3D(static_cast<ai_real>(f), static_cast<ai_real>(i), 0);
+            weights[FaceBones[f][i == 0 ? 0 : 1]].emplace_back(f * 3 + i, 1.0f);
+        }
+    }
+    mesh->mBones = new aiBone *[mesh->mNumBones = 8];
+    for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+        aiBone *bone = mesh->mBones[b] = new aiBone();
+        bone->mName.Set("bone_" + std::to_string(b));
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights = static_cast<unsigned int>(weights[b].size())];
+        std::copy(weights[b].begin(), weights[b].end(), bone->mWeights);
+    }
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES, 4);
+    mProcess.SetupProperties(&importer);
+    mProcess.Execute(mScene);
+
+    ASSERT_EQ(3u, mScene->mNumMeshes);
+    for (unsigned int m = 1; m < mScene->mNumMeshes; ++m) {
+        const aiMesh *sub = mScene->mMeshes[m];
+        ASSERT_EQ(4u, sub->mNumBones);
+        EXPECT_EQ(3u, sub->mNumFaces);
+
+        // all bones of a submesh belong to the same chain
+        const unsigned int chain = std::stoi(sub->mBones[0]->mName.C_Str() + 5) / 4;
+        for (unsigned int b = 1; b < sub->mNumBones; ++b) {
+            EXPECT_EQ(chain, std::stoi(sub->mBones[b]->mName.C_Str() + 5) / 4u);
+        }
+    }
+}
@@ -135,3 +135,45 @@ TEST_F(TriangulateProcessTest, testTriangulation) {
     // we should have no valid normal vectors now because we aren't a pure polygon mesh
     EXPECT_TRUE(pcMesh->mNormals == nullptr);
 }
+
+TEST_F(TriangulateProcessTest, testLargeConcavePolygon) {
+    // a star with many spikes in the xy plane, ccw winding
+    constexpr unsigned int NumPoints = 4000;
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->mNumVertices = NumPoints;
+    mesh->mVertices = new aiVector3D[NumPoints];
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[1];
+    mesh->mFaces[0].mNumIndices = NumPoints;
+    mesh->mFaces[0].mIndices = new unsigned int[NumPoints];
+
+    double area = 0.0;
+    for (unsigned int i = 0; i < NumPoints; ++i) {
+        const float radius = (i % 2) ? 0.5f : 1.f;
+        const float angle = i * (float)AI_MATH_TWO_PI / NumPoints;
+        mesh->mVertices[i] = aiVector3D(radius * cos(angle), radius * sin(angle), 0.f);
+        mesh->mFaces[0].mIndices[i] = i;
+    }
+    for (unsigned int i = 0; i < NumPoints; ++i) {
+        const aiVector3D &a = mesh->mVertices[i], &b = mesh->mVertices[(i + 1) % NumPoints];
+        area += 0.5 * ((double)a.x * b.y - (double)b.x * a.y);
+    }
+
+    EXPECT_TRUE(piProcess->TriangulateMesh(mesh));
+    ASSERT_EQ(NumPoints - 2, mesh->mNumFaces);
+
+    double triangulatedArea = 0.0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const aiFace &face = mesh->mFaces[i];
+        ASSERT_EQ(3u, face.mNumIndices);
+        const aiVector3D &a = mesh->mVertices[face.mIndices[0]];
+        const aiVector3D &b = mesh->mVertices[face.mIndices[1]];
+        const aiVector3D &c = mesh->mVertices[face.mIndices[2]];
+        const double triArea = 0.5 * (((double)b.x - a.x) * ((double)c.y - a.y) - ((double)c.x - a.x) * ((double)b.y - a.y));
+        EXPECT_GE(triArea, 0.0);
+        triangulatedArea += triArea;
+    }
+    EXPECT_NEAR(area, triangulatedArea, 1e-4);
+    delete mesh;
+}
@@ -44,7 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
-#include <ValidateDataStructure.h>
+#include <assimp/Exceptional.h>
+#include "PostProcessing/ValidateDataStructure.h"
 
 using namespace std;
 using namespace Assimp;
@@ -88,7 +89,61 @@ void ValidateDataStructureTest::TearDown()
     delete scene;
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testDuplicateCameraNames)
+{
+    scene->mFlags = AI_SCENE_FLAGS_INCOMPLETE;
+    scene->mNumCameras = 2;
+    scene->mCameras = new aiCamera*[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        scene->mCameras[i] = new aiCamera();
+        scene->mCameras[i]->mName.Set("<test>");
+    }
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    // distinct names, each with its own node
+    aiNode *other = new aiNode("<other>");
+    scene->mRootNode->addChildren(1, &other);
+    scene->mCameras[1]->mName.Set("<other>");
+    EXPECT_NO_THROW(vds->Execute(scene));
+
+    scene->mCameras[1]->mName.Set("<test>");
+    scene->mNumCameras = 1;
+    EXPECT_NO_THROW(vds->Execute(scene));
+    scene->mNumCameras = 2;
+}
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testStructuralOnly)
+{
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 3;
+    mesh->mVertices = new aiVector3D[3];
+    mesh->mNumFaces = 1;
+    mesh->mFaces = new aiFace[1];
+    mesh->mFaces[0].mNumIndices = 3;
+    mesh->mFaces[0].mIndices = new unsigned int[3];
+    mesh->mFaces[0].mIndices[0] = 0;
+    mesh->mFaces[0].mIndices[1] = 1;
+    mesh->mFaces[0].mIndices[2] = 5;
+
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh*[1];
+    scene->mMeshes[0] = mesh;
+
+    EXPECT_FALSE(vds->IsStructuralOnly());
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    vds->EnableStructuralOnly(true);
+    EXPECT_NO_THROW(vds->Execute(scene));
+
+    // null pointers are still caught
+    unsigned int *indices = mesh->mFaces[0].mIndices;
+    mesh->mFaces[0].mIndices = nullptr;
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+    mesh->mFaces[0].mIndices = indices;
+}
 
 // ------------------------------------------------------------------------------------------------
 //Template
@@ -195,5 +250,4 @@ void ValidateDataStructureTest::TearDown()
 //965: ReportError("aiString::length is too large (%i, maximum is %lu)",
 //974: ReportError("aiString::data is invalid: the terminal zero is at a wrong offset");
 //979: ReportError("aiString::data is invalid. There is no terminal character");
-}
-
+//}
@@ -727,6 +727,36 @@ TEST_F(utglTF2ImportExport, export_normalized_normals) {
     }
 }
 
+TEST_F(utglTF2ImportExport, export_quantized_attributes) {
+    Assimp::Importer importer;
+    Assimp::Exporter exporter;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(scene, nullptr);
+    ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE_ATTRIBUTES, true);
+    EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "glb2", ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_quantized_out.glb", 0u, &properties));
+
+    // the exporter flips the texture coordinates in place, so start from a fresh copy
+    scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(scene, nullptr);
+    Assimp::Importer quantizedImporter;
+    const aiScene *quantized = quantizedImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured_quantized_out.glb", aiProcess_ValidateDataStructure);
+    ASSERT_NE(quantized, nullptr);
+
+    const aiMesh *mesh = scene->mMeshes[0], *quantizedMesh = quantized->mMeshes[0];
+    ASSERT_EQ(mesh->mNumVertices, quantizedMesh->mNumVertices);
+    ASSERT_TRUE(quantizedMesh->HasNormals());
+    ASSERT_TRUE(quantizedMesh->HasTextureCoords(0));
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(mesh->mVertices[i], quantizedMesh->mVertices[i]);
+        EXPECT_NEAR(mesh->mNormals[i].x, quantizedMesh->mNormals[i].x, 1.f / 127);
+        EXPECT_NEAR(mesh->mNormals[i].y, quantizedMesh->mNormals[i].y, 1.f / 127);
+        EXPECT_NEAR(mesh->mNormals[i].z, quantizedMesh->mNormals[i].z, 1.f / 127);
+        EXPECT_NEAR(mesh->mTextureCoords[0][i].x, quantizedMesh->mTextureCoords[0][i].x, 1.f / 65535);
+        EXPECT_NEAR(mesh->mTextureCoords[0][i].y, quantizedMesh->mTextureCoords[0][i].y, 1.f / 65535);
+    }
+}
+
 #endif // ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utglTF2ImportExport, sceneMetadata) {